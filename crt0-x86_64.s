@@ -0,0 +1,20 @@
+# SPDX-License-Identifier: LGPL-2.1-only
+
+.text
+
+.globl _start
+
+_start: # _start is the entry point known to the linker
+    xor %ebp, %ebp            # RBP := 0, marks the outermost frame
+    call init_heap            # Initialize the heap (RSP is 16-byte aligned here)
+    call __clock_init         # Anchor the TSC clock
+
+    movq (%rsp), %rdi         # Get argc from the stack
+    leaq 8(%rsp), %rsi        # Get the address of argv
+    leaq 8(%rsi,%rdi,8), %rdx # Get the address of envp
+    movq %rdx, environ(%rip)  # Keep it around for getenv() and friends
+
+    call main                 # Call main(argc, argv, envp)
+
+    movl %eax, %edi           # Pass main's return value along
+    call exit                 # exit() flushes profiling counters, then syscall 6
@@ -6,11 +6,13 @@
 
 _start: # _start is the entry point known to the linker
     call init_heap            # Initialize the heap
+    call __clock_init         # Anchor the TSC clock
 
     xor %ebp, %ebp            # EBP := 0, because we like tidy stack frames
     movl (%esp), %eax          # Get argc from the stack
     lea 4(%esp), %ecx         # Get the address of argv
     lea 4(%ecx,%eax,4), %edx  # Get the address of envp
+    movl %edx, environ        # Keep it around for getenv() and friends
     xor %ebx, %ebx            # Clear EBX because it's polite, and also ABI-compliant
 
     pushl %edx                 # Push envp
@@ -18,7 +20,5 @@ _start: # _start is the entry point known to the linker
     pushl %eax                 # Push argc
     call main                 # Call main(argc, argv, envp)
 
-    movl %eax, %ebx            # Transfer main's return value into EBX
-    xor %eax, %eax            # Clear EAX for syscall cleanliness
-    movl $6, %eax             # Exit syscall is 6
-    int $0x80                 # Call _exit via syscall
+    pushl %eax                 # Pass main's return value along
+    call exit                 # exit() flushes profiling counters, then syscall 6
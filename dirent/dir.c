@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * dirent/dir.c
+ * 
+ * Directory streams.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <syscall.h>
+
+DIR* fdopendir(int fd) {
+    if (fd < 0) return NULL;
+
+    // Stream and buffer in one allocation
+    DIR* dir = malloc(sizeof(DIR) + DIR_BUF_SIZE);
+    if (!dir) return NULL;
+    dir->fd = fd;
+    dir->pos = 0;
+    dir->len = 0;
+    dir->size = DIR_BUF_SIZE;
+    dir->buf = (char*)(dir + 1);
+    dir->error = 0;
+    return dir;
+}
+
+DIR* opendir(const char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    DIR* dir = fdopendir(fd);
+    if (!dir) close(fd);
+    return dir;
+}
+
+struct dirent* readdir(DIR* dir) {
+    if (dir->pos >= dir->len) {
+        long n = __syscall3(SYS_GETDENTS, dir->fd, (long)dir->buf, (long)dir->size);
+        if (n < 0) dir->error = 1;
+        if (n <= 0) return NULL;
+        dir->len = (size_t)n;
+        dir->pos = 0;
+    }
+
+    struct dirent* ent = (struct dirent*)(dir->buf + dir->pos);
+    dir->pos += ent->d_reclen;
+    return ent;
+}
+
+int closedir(DIR* dir) {
+    int ret = close(dir->fd);
+    free(dir);
+    return ret;
+}
+
+int dirfd(DIR* dir) {
+    return dir->fd;
+}
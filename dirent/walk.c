@@ -0,0 +1,219 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * dirent/walk.c
+ * 
+ * Recursive directory walk.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <ftw.h>
+#include <strbuf.h>
+#include <syscall.h>
+
+// Directories are opened without following links or waiting on FIFOs
+// and devices; O_DIRECTORY makes the open itself the type test.
+#define DIR_OPEN_FLAGS (O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_NONBLOCK)
+
+// One getdents buffer per depth, kept for the whole walk. Entries of a
+// directory stay valid while its subdirectories are being read.
+struct level {
+    char* buf;
+    size_t size;
+};
+
+struct walk {
+    ftw_fn fn;
+    void* ctx;
+    int flags;
+    int nopenfd;
+    strbuf path;
+    struct level* levels;
+    int nlevels;
+};
+
+static struct level* get_level(struct walk* w, int level) {
+    if (level >= w->nlevels) {
+        int n = w->nlevels ? w->nlevels * 2 : 8;
+        while (n <= level) n *= 2;
+        struct level* levels = realloc(w->levels, n * sizeof(*levels));
+        if (!levels) return NULL;
+        for (int i = w->nlevels; i < n; i++) {
+            levels[i].buf = NULL;
+            levels[i].size = 0;
+        }
+        w->levels = levels;
+        w->nlevels = n;
+    }
+    struct level* lv = &w->levels[level];
+    if (!lv->buf) {
+        lv->buf = malloc(DIR_BUF_SIZE);
+        if (!lv->buf) return NULL;
+        lv->size = DIR_BUF_SIZE;
+    }
+    return lv;
+}
+
+// Read the rest of dir into the level buffer, growing it as needed. A
+// failed read is left in dir->error; -1 means out of memory.
+static int read_all(struct level* lv, DIR* dir) {
+    for (;;) {
+        if (lv->size - dir->len < DIR_BUF_SIZE) {
+            char* buf = realloc(lv->buf, lv->size * 2);
+            if (!buf) return -1;
+            lv->buf = dir->buf = buf;
+            lv->size = dir->size = lv->size * 2;
+        }
+        long n = __syscall3(SYS_GETDENTS, dir->fd, (long)(dir->buf + dir->len),
+                            (long)(dir->size - dir->len));
+        if (n < 0) dir->error = 1;
+        if (n <= 0) return 0;
+        dir->len += (size_t)n;
+    }
+}
+
+// readdir, except that a directory read in full by read_all ends at the
+// end of its buffer.
+static struct dirent* next_entry(DIR* dir, int in_memory) {
+    if (in_memory && dir->pos >= dir->len) return NULL;
+    return readdir(dir);
+}
+
+static int is_dot(const char* name) {
+    return name[0] == '.' && (!name[1] || (name[1] == '.' && !name[2]));
+}
+
+static int walk_dir(struct walk* w, int fd, int level, int base);
+static int walk_path(struct walk* w, int level, int base);
+
+// Report one entry of the directory at w->path[0..dir_len).
+static int visit(struct walk* w, const struct dirent* ent, size_t dir_len,
+                 int need_slash, int level) {
+    sb_truncate(&w->path, dir_len);
+    if (need_slash && sb_appendc(&w->path, '/') != 0) return -1;
+    struct FTW ftw = { (int)w->path.len, level };
+    if (sb_append(&w->path, ent->d_name) != 0) return -1;
+    const char* path = sb_str(&w->path);
+
+    switch (ent->d_type) {
+        case DT_DIR: {
+            int fd = open(path, DIR_OPEN_FLAGS);
+            if (fd < 0)
+                return w->fn(path, FTW_DNR, &ftw, w->ctx);
+            return walk_dir(w, fd, level, ftw.base);
+        }
+        case DT_UNKNOWN:
+            return walk_path(w, level, ftw.base);
+        case DT_LNK:
+            return w->fn(path, FTW_SL, &ftw, w->ctx);
+        default:
+            return w->fn(path, FTW_F, &ftw, w->ctx);
+    }
+}
+
+// Walk the directory open on fd, whose path is in w->path. Takes
+// ownership of fd.
+static int walk_dir(struct walk* w, int fd, int level, int base) {
+    struct FTW ftw = { base, level };
+    int ret;
+
+    struct level* lv = get_level(w, level);
+    if (!lv) {
+        close(fd);
+        return -1;
+    }
+    DIR dir = { fd, 0, 0, lv->size, lv->buf, 0 };
+
+    // Directories from depth nopenfd - 1 down are read whole and closed
+    // before any descent, so no more than nopenfd are ever open.
+    int in_memory = level + 1 >= w->nopenfd;
+    if (in_memory) {
+        ret = read_all(lv, &dir);
+        close(fd);
+        fd = -1;
+        if (ret) return -1;
+    }
+
+    struct dirent* ent = next_entry(&dir, in_memory);
+    if (!ent && dir.error) {
+        if (fd >= 0) close(fd);
+        return w->fn(sb_str(&w->path), FTW_DNR, &ftw, w->ctx);
+    }
+
+    if (!(w->flags & FTW_DEPTH)) {
+        ret = w->fn(sb_str(&w->path), FTW_D, &ftw, w->ctx);
+        if (ret) {
+            if (fd >= 0) close(fd);
+            return ret;
+        }
+    }
+
+    size_t dir_len = w->path.len;
+    int need_slash = dir_len && sb_str(&w->path)[dir_len - 1] != '/';
+    ret = 0;
+    while (ent && !ret) {
+        if (!is_dot(ent->d_name))
+            ret = visit(w, ent, dir_len, need_slash, level + 1);
+        if (!ret) ent = next_entry(&dir, in_memory);
+    }
+
+    // The kernel failed partway through the listing: whatever came after
+    // was never seen, so the walk can't claim to be complete.
+    if (!ret && dir.error) ret = -1;
+
+    if (fd >= 0) close(fd);
+    sb_truncate(&w->path, dir_len);
+    if (!ret && (w->flags & FTW_DEPTH))
+        ret = w->fn(sb_str(&w->path), FTW_DP, &ftw, w->ctx);
+    return ret;
+}
+
+// w->path with no type to go on: the starting path, or an entry listed
+// as DT_UNKNOWN. If it opens as a directory it is one; otherwise opening
+// it as a file, still without following or blocking, tells a file from
+// a link or something unreadable.
+static int walk_path(struct walk* w, int level, int base) {
+    struct FTW ftw = { base, level };
+    const char* path = sb_str(&w->path);
+
+    int fd = open(path, DIR_OPEN_FLAGS);
+    if (fd >= 0)
+        return walk_dir(w, fd, level, base);
+
+    fd = open(path, O_RDONLY | O_NOFOLLOW | O_NONBLOCK);
+    if (fd < 0)
+        return w->fn(path, FTW_NS, &ftw, w->ctx);
+    close(fd);
+    return w->fn(path, FTW_F, &ftw, w->ctx);
+}
+
+int ftw_walk(const char* path, ftw_fn fn, void* ctx, int nopenfd, int flags) {
+    struct walk w = { 0 };
+    w.fn = fn;
+    w.ctx = ctx;
+    w.flags = flags;
+    w.nopenfd = nopenfd < 1 ? 1 : nopenfd;
+    sb_init(&w.path);
+    if (sb_append(&w.path, path) != 0) {
+        sb_free(&w.path);
+        return -1;
+    }
+
+    int base = 0;
+    for (int i = 0; path[i]; i++)
+        if (path[i] == '/' && path[i + 1]) base = i + 1;
+
+    int ret = walk_path(&w, 0, base);
+
+    for (int i = 0; i < w.nlevels; i++)
+        free(w.levels[i].buf);
+    free(w.levels);
+    sb_free(&w.path);
+    return ret;
+}
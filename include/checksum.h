@@ -0,0 +1,17 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// All checksums can be computed incrementally: pass the previous result
+// back in with the next buffer. Start CRCs at 0 and Adler-32 at 1.
+uint32_t crc32(uint32_t crc, const void* buf, size_t len);
+uint32_t crc32c(uint32_t crc, const void* buf, size_t len);
+uint32_t adler32(uint32_t adler, const void* buf, size_t len);
+
+uint64_t xxhash64(const void* buf, size_t len, uint64_t seed);
+
+#endif // CHECKSUM_H
@@ -0,0 +1,48 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef DIRENT_H
+#define DIRENT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Entry types, as reported by the kernel in d_type.
+#define DT_UNKNOWN  0
+#define DT_FIFO     1
+#define DT_CHR      2
+#define DT_DIR      4
+#define DT_BLK      6
+#define DT_REG      8
+#define DT_LNK      10
+#define DT_SOCK     12
+
+// Records are returned in the kernel's layout; d_name is NUL-terminated
+// and only as long as d_reclen allows, not the full 256 bytes.
+struct dirent {
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[256];
+};
+
+// One getdents call fills the whole buffer, so a directory costs about
+// one syscall per DIR_BUF_SIZE bytes of entries.
+#define DIR_BUF_SIZE (32 * 1024)
+
+typedef struct {
+    int fd;
+    size_t pos;
+    size_t len;
+    size_t size;
+    char* buf;
+    int error;      // a read failed; readdir's NULL was not the end
+} DIR;
+
+DIR* opendir(const char* path);
+DIR* fdopendir(int fd);
+struct dirent* readdir(DIR* dir);
+int closedir(DIR* dir);
+int dirfd(DIR* dir);
+
+#endif // DIRENT_H
@@ -0,0 +1,29 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef ERRNO_H
+#define ERRNO_H
+
+/*
+ * Error numbers. There is no errno variable: functions that report a
+ * reason (the pthread and posix_spawn families) return one of these
+ * directly; the rest return -1. Values match Linux.
+ */
+#define ENOENT      2
+#define EINTR       4
+#define EIO         5
+#define E2BIG       7
+#define ENOEXEC     8
+#define EBADF       9
+#define ECHILD      10
+#define EAGAIN      11
+#define ENOMEM      12
+#define EACCES      13
+#define EBUSY       16
+#define ENOTDIR     20
+#define EINVAL      22
+#define EMFILE      24
+#define ERANGE      34
+#define EDEADLK     35
+#define ELOOP       40
+
+#endif // ERRNO_H
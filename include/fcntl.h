@@ -8,4 +8,18 @@
 #define O_WRONLY 2
 #define O_RDWR 3
 
+#define O_NONBLOCK  0x800       // don't wait on FIFOs and devices
+#define O_DIRECTORY 0x10000     // fail unless path is a directory
+#define O_NOFOLLOW  0x20000     // fail if path is a symbolic link
+
+#define F_DUPFD         0
+#define F_GETFD         1
+#define F_SETFD         2
+#define F_DUPFD_CLOEXEC 1030
+
+#define FD_CLOEXEC      1
+
+int open(const char* path, int flags);
+int fcntl(int fd, int cmd, int arg);
+
 #endif // FCNTL_H
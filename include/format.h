@@ -0,0 +1,15 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef FORMAT_H
+#define FORMAT_H
+
+#include <stdarg.h>
+#include <stddef.h>
+
+// The printf engine behind every formatting function. put() receives
+// the output in chunks; the return value is the total length produced.
+typedef void (*format_put)(void* ctx, const char* s, size_t n);
+
+int __vformat(format_put put, void* ctx, const char* fmt, va_list args);
+
+#endif // FORMAT_H
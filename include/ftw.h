@@ -0,0 +1,43 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef FTW_H
+#define FTW_H
+
+// Type passed to the callback
+#define FTW_F   0   // not a directory
+#define FTW_D   1   // directory, before its contents
+#define FTW_DNR 2   // directory that could not be opened
+#define FTW_NS  3   // path could not be opened at all
+#define FTW_SL  4   // symbolic link (never followed)
+#define FTW_DP  5   // directory, after its contents (FTW_DEPTH)
+
+// Flags
+#define FTW_DEPTH 8 // report directories after their contents
+
+struct FTW {
+    int base;   // offset of the last component in path
+    int level;  // depth below the starting path
+};
+
+// Return nonzero from the callback to stop the walk; that value is then
+// returned by ftw_walk.
+typedef int (*ftw_fn)(const char* path, int type, const struct FTW* ftw, void* ctx);
+
+/*
+ * Walk the tree under path. Types come from the directory entries
+ * themselves, so no stat() is made per file. Unlike nftw, the callback
+ * gets no struct stat; call stat() yourself where you need one.
+ *
+ * Symbolic links are never followed, including path itself, and
+ * nothing is opened in a way that can block on a FIFO or device. Where
+ * the type has to be found by opening (path, and entries the kernel
+ * lists as DT_UNKNOWN), a link or anything unreadable is FTW_NS.
+ *
+ * At most nopenfd directories are held open at once (minimum 1);
+ * deeper directories are read into memory and closed before the walk
+ * descends. A directory that can't be read at all is FTW_DNR; a read
+ * that fails partway stops the walk with -1.
+ */
+int ftw_walk(const char* path, ftw_fn fn, void* ctx, int nopenfd, int flags);
+
+#endif // FTW_H
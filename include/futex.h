@@ -0,0 +1,9 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef FUTEX_H
+#define FUTEX_H
+
+int futex_wait(volatile int *addr, int val);
+int futex_wake(volatile int *addr, int count);
+
+#endif // FUTEX_H
@@ -0,0 +1,14 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef HASH_H
+#define HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Fast non-cryptographic 64-bit hash (wyhash family). Good avalanche
+// behaviour, no table lookups; not for anything security-sensitive.
+uint64_t hash_bytes(const void* data, size_t len, uint64_t seed);
+uint64_t hash_str(const char* str, uint64_t seed);
+
+#endif // HASH_H
@@ -0,0 +1,58 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef HASHMAP_H
+#define HASHMAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Allocator hook so maps can live in arenas. size is passed to free so
+// simple bump/arena allocators don't need to track it themselves.
+typedef struct {
+    void* (*alloc)(void* ctx, size_t size);
+    void (*free)(void* ctx, void* ptr, size_t size);
+    void* ctx;
+} hm_allocator;
+
+// Keys are not copied: the map stores the pointer and length it was
+// given, and the caller keeps that memory alive while it's in the map.
+struct hm_slot {
+    const void* key;
+    size_t len;
+    void* value;
+};
+
+// Open-addressing table with one control byte per slot (Swiss-table
+// layout). A control byte holds 7 bits of the key's hash for full
+// slots, so a probe compares a whole group of slots at once and only
+// touches the slot array on a likely match.
+typedef struct {
+    int8_t* ctrl;
+    struct hm_slot* slots;
+    size_t capacity;        // 0 or a power of two >= group width
+    size_t size;
+    size_t growth_left;     // inserts left before a rehash
+    uint64_t seed;
+    hm_allocator alloc;
+} hashmap;
+
+void hashmap_init(hashmap* m, const hm_allocator* alloc);  // alloc NULL = malloc/free
+void hashmap_destroy(hashmap* m);
+int hashmap_reserve(hashmap* m, size_t n);
+void hashmap_clear(hashmap* m);
+
+struct hm_slot* hashmap_find(const hashmap* m, const void* key, size_t len);
+void* hashmap_get(const hashmap* m, const void* key, size_t len);
+int hashmap_put(hashmap* m, const void* key, size_t len, void* value);
+int hashmap_remove(hashmap* m, const void* key, size_t len);
+
+// Iteration: start with *iter = 0; returns NULL when done. Inserting
+// during iteration may rehash and invalidates the iterator.
+struct hm_slot* hashmap_next(const hashmap* m, size_t* iter);
+
+#define hashmap_get_str(m, s)       hashmap_get((m), (s), strlen(s))
+#define hashmap_put_str(m, s, v)    hashmap_put((m), (s), strlen(s), (v))
+#define hashmap_remove_str(m, s)    hashmap_remove((m), (s), strlen(s))
+
+#endif // HASHMAP_H
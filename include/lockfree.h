@@ -0,0 +1,56 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef LOCKFREE_H
+#define LOCKFREE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#define LF_CACHELINE 64
+
+// Bounded multi-producer/multi-consumer ring queue. Each slot carries a
+// sequence number telling producers and consumers whose turn it is, so
+// the only shared writes are one CAS on the head or tail index.
+struct lf_cell {
+    atomic_size_t seq;
+    void* data;
+};
+
+typedef struct {
+    struct lf_cell* cells;
+    size_t mask;
+    char pad0[LF_CACHELINE];
+    atomic_size_t enqueue_pos;
+    char pad1[LF_CACHELINE - sizeof(size_t)];
+    atomic_size_t dequeue_pos;
+    char pad2[LF_CACHELINE - sizeof(size_t)];
+} lf_queue;
+
+int lf_queue_init(lf_queue* q, size_t capacity);    // capacity: power of two
+void lf_queue_destroy(lf_queue* q);
+int lf_queue_push(lf_queue* q, void* data);          // 0 on success, -1 if full
+int lf_queue_pop(lf_queue* q, void** data);          // 0 on success, -1 if empty
+
+// Intrusive Treiber stack. The head packs a node pointer with a
+// modification tag into one 64-bit word, so a node popped and pushed
+// back between another thread's load and CAS can't be mistaken for an
+// unchanged head (the ABA problem). The link lives in the node, so the
+// stack can't detect a node pushed while it is already on it; that
+// makes a cycle, and callers must rule it out.
+struct lf_node {
+    struct lf_node* next;
+};
+
+typedef struct {
+    volatile uint64_t head;
+} lf_stack;
+
+#define LF_STACK_INIT { 0 }
+
+void lf_stack_push(lf_stack* s, struct lf_node* node);
+struct lf_node* lf_stack_pop(lf_stack* s);
+struct lf_node* lf_stack_pop_all(lf_stack* s);
+int lf_stack_empty(lf_stack* s);
+
+#endif // LOCKFREE_H
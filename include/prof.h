@@ -0,0 +1,43 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef PROF_H
+#define PROF_H
+
+#include <stdint.h>
+#include <syscall.h>
+
+/*
+ * Hot-path counters, compiled in with `make PROFILE=1`
+ * (-DGOLDLIBC_PROFILE). Each site counts calls, bytes and TSC cycles;
+ * exit() prints the table. Without the flag the macros expand to
+ * nothing.
+ */
+
+enum prof_site {
+    PROF_MALLOC,
+    PROF_FREE,
+    PROF_MEMCPY,
+    PROF_MEMSET,
+    PROF_PRINTF,
+    PROF_SYSCALL,                       // one slot per syscall number,
+    PROF_NSYSCALLS = SYS_MAX + 1,       // and one for anything out of range
+    PROF_NSITES = PROF_SYSCALL + PROF_NSYSCALLS
+};
+
+#ifdef GOLDLIBC_PROFILE
+
+void __prof_record(int site, uint64_t bytes, uint64_t cycles);
+void __prof_syscall(long n, long ret, uint64_t start);
+void __prof_dump(void);
+
+#define PROF_START(t)               uint64_t t = __builtin_ia32_rdtsc()
+#define PROF_STOP(site, t, bytes)   __prof_record((site), (bytes), __builtin_ia32_rdtsc() - (t))
+
+#else
+
+#define PROF_START(t)               do { } while (0)
+#define PROF_STOP(site, t, bytes)   do { } while (0)
+
+#endif
+
+#endif // PROF_H
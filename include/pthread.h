@@ -0,0 +1,71 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef PTHREAD_H
+#define PTHREAD_H
+
+#include <stddef.h>
+
+#define PTHREAD_KEYS_MAX        32
+#define PTHREAD_STACK_DEFAULT   (64 * 1024)
+
+typedef struct pthread* pthread_t;
+typedef unsigned int pthread_key_t;
+
+typedef struct {
+    size_t stack_size;
+} pthread_attr_t;
+
+// 0 = unlocked, 1 = locked, 2 = locked with waiters
+typedef struct {
+    volatile int state;
+} pthread_mutex_t;
+
+typedef struct {
+    volatile int seq;
+} pthread_cond_t;
+
+typedef volatile int pthread_once_t;
+
+// state: >0 reader count, -1 writer, 0 free
+typedef struct {
+    volatile int state;
+    volatile int waiters;
+    volatile int writers_waiting;
+} pthread_rwlock_t;
+
+#define PTHREAD_MUTEX_INITIALIZER   { 0 }
+#define PTHREAD_COND_INITIALIZER    { 0 }
+#define PTHREAD_ONCE_INIT           0
+#define PTHREAD_RWLOCK_INITIALIZER  { 0, 0, 0 }
+
+int pthread_create(pthread_t* thread, const pthread_attr_t* attr,
+                   void* (*start)(void*), void* arg);
+int pthread_join(pthread_t thread, void** result);
+void pthread_exit(void* result);
+pthread_t pthread_self(void);
+
+int pthread_key_create(pthread_key_t* key, void (*destructor)(void*));
+void* pthread_getspecific(pthread_key_t key);
+int pthread_setspecific(pthread_key_t key, const void* value);
+
+int pthread_mutex_init(pthread_mutex_t* m, const void* attr);
+int pthread_mutex_lock(pthread_mutex_t* m);
+int pthread_mutex_trylock(pthread_mutex_t* m);
+int pthread_mutex_unlock(pthread_mutex_t* m);
+int pthread_mutex_destroy(pthread_mutex_t* m);
+
+int pthread_cond_init(pthread_cond_t* c, const void* attr);
+int pthread_cond_wait(pthread_cond_t* c, pthread_mutex_t* m);
+int pthread_cond_signal(pthread_cond_t* c);
+int pthread_cond_broadcast(pthread_cond_t* c);
+int pthread_cond_destroy(pthread_cond_t* c);
+
+int pthread_once(pthread_once_t* once, void (*fn)(void));
+
+int pthread_rwlock_init(pthread_rwlock_t* rw, const void* attr);
+int pthread_rwlock_rdlock(pthread_rwlock_t* rw);
+int pthread_rwlock_wrlock(pthread_rwlock_t* rw);
+int pthread_rwlock_unlock(pthread_rwlock_t* rw);
+int pthread_rwlock_destroy(pthread_rwlock_t* rw);
+
+#endif // PTHREAD_H
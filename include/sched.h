@@ -0,0 +1,8 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef SCHED_H
+#define SCHED_H
+
+int sched_yield(void);
+
+#endif // SCHED_H
@@ -0,0 +1,95 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef SORT_IMPL_H
+#define SORT_IMPL_H
+
+/*
+ * Internal: the element swaps and partition step shared by qsort
+ * (stdlib/sort.c) and parallel_qsort (task/parallel.c).
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef int (*cmp_fn)(const void*, const void*);
+typedef void (*swap_fn)(char*, char*, size_t);
+
+// --------------------------------------------------
+// Element swaps, specialized by size
+// --------------------------------------------------
+static inline void swap4(char* a, char* b, size_t size) {
+    (void)size;
+    uint32_t t;
+    __builtin_memcpy(&t, a, 4);
+    __builtin_memcpy(a, b, 4);
+    __builtin_memcpy(b, &t, 4);
+}
+
+static inline void swap8(char* a, char* b, size_t size) {
+    (void)size;
+    uint64_t t;
+    __builtin_memcpy(&t, a, 8);
+    __builtin_memcpy(a, b, 8);
+    __builtin_memcpy(b, &t, 8);
+}
+
+static inline void swap16(char* a, char* b, size_t size) {
+    (void)size;
+    uint64_t t[2];
+    __builtin_memcpy(t, a, 16);
+    __builtin_memcpy(a, b, 16);
+    __builtin_memcpy(b, t, 16);
+}
+
+static inline void swap_generic(char* a, char* b, size_t size) {
+    while (size >= sizeof(uintptr_t)) {
+        uintptr_t t;
+        __builtin_memcpy(&t, a, sizeof(t));
+        __builtin_memcpy(a, b, sizeof(t));
+        __builtin_memcpy(b, &t, sizeof(t));
+        a += sizeof(t);
+        b += sizeof(t);
+        size -= sizeof(t);
+    }
+    while (size--) {
+        char t = *a;
+        *a++ = *b;
+        *b++ = t;
+    }
+}
+
+static inline swap_fn pick_swap(size_t size) {
+    switch (size) {
+        case 4:  return swap4;
+        case 8:  return swap8;
+        case 16: return swap16;
+        default: return swap_generic;
+    }
+}
+
+// Median-of-three Hoare partition with the pivot parked at a[0]. Equal
+// keys stop both scans, so inputs full of duplicates still split evenly.
+static inline size_t partition(char* a, size_t n, size_t size, cmp_fn cmp, swap_fn swap) {
+    char* lo = a;
+    char* mid = a + (n / 2) * size;
+    char* hi = a + (n - 1) * size;
+
+    if (cmp(mid, lo) < 0) swap(mid, lo, size);
+    if (cmp(hi, mid) < 0) {
+        swap(hi, mid, size);
+        if (cmp(mid, lo) < 0) swap(mid, lo, size);
+    }
+    swap(lo, mid, size);
+
+    size_t i = 0, j = n;
+    for (;;) {
+        do ++i; while (i < n && cmp(a + i * size, a) < 0);
+        do --j; while (cmp(a + j * size, a) > 0);
+        if (i >= j) break;
+        swap(a + i * size, a + j * size, size);
+    }
+    swap(a, a + j * size, size);
+    return j;
+}
+
+#endif // SORT_IMPL_H
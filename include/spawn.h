@@ -0,0 +1,51 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef SPAWN_H
+#define SPAWN_H
+
+#include <sys/types.h>
+
+/*
+ * WARNING: the kernel has no way to run file actions in the child, so
+ * posix_spawn applies them to the CALLING PROCESS's descriptor table,
+ * spawns, and then puts the table back. Other threads share that table:
+ * while a spawn with file actions is in progress they see its targets
+ * closed, replaced or newly opened. Don't open, close or use those
+ * descriptor numbers from other threads during the call. Spawns are
+ * serialized against each other, but not against anything else.
+ *
+ * Every function here returns 0 or an error number from <errno.h>.
+ */
+
+struct spawn_action;
+
+typedef struct {
+    int count;
+    int cap;
+    struct spawn_action* actions;
+} posix_spawn_file_actions_t;
+
+typedef struct {
+    int flags;  // reserved
+} posix_spawnattr_t;
+
+int posix_spawn_file_actions_init(posix_spawn_file_actions_t* fa);
+int posix_spawn_file_actions_destroy(posix_spawn_file_actions_t* fa);
+int posix_spawn_file_actions_adddup2(posix_spawn_file_actions_t* fa, int fd, int newfd);
+int posix_spawn_file_actions_addclose(posix_spawn_file_actions_t* fa, int fd);
+int posix_spawn_file_actions_addopen(posix_spawn_file_actions_t* fa, int fd,
+                                     const char* path, int oflag, mode_t mode);
+
+int posix_spawnattr_init(posix_spawnattr_t* attr);
+int posix_spawnattr_destroy(posix_spawnattr_t* attr);
+
+// Returns 0 and stores the child's pid, or an error number: ENOMEM,
+// EMFILE (no room to save a target descriptor), EBADF or ENOENT (a file
+// action or the spawn itself failed). On error the descriptor table is
+// as it was before the call.
+int posix_spawn(pid_t* pid, const char* path,
+                const posix_spawn_file_actions_t* fa,
+                const posix_spawnattr_t* attr,
+                char* const argv[], char* const envp[]);
+
+#endif // SPAWN_H
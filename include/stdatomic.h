@@ -0,0 +1,131 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef STDATOMIC_H
+#define STDATOMIC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum {
+    memory_order_relaxed = __ATOMIC_RELAXED,
+    memory_order_consume = __ATOMIC_CONSUME,
+    memory_order_acquire = __ATOMIC_ACQUIRE,
+    memory_order_release = __ATOMIC_RELEASE,
+    memory_order_acq_rel = __ATOMIC_ACQ_REL,
+    memory_order_seq_cst = __ATOMIC_SEQ_CST
+} memory_order;
+
+typedef _Atomic int atomic_int;
+typedef _Atomic unsigned int atomic_uint;
+typedef _Atomic long atomic_long;
+typedef _Atomic unsigned long atomic_ulong;
+typedef _Atomic size_t atomic_size_t;
+typedef _Atomic intptr_t atomic_intptr_t;
+typedef _Atomic uintptr_t atomic_uintptr_t;
+typedef _Atomic _Bool atomic_bool;
+
+#define ATOMIC_VAR_INIT(v) (v)
+
+// Word-sized and smaller operations. On x86 these compile to plain
+// moves for loads/stores and a single lock-prefixed instruction for
+// read-modify-write.
+#define atomic_load_explicit(p, o)          __atomic_load_n((p), (o))
+#define atomic_store_explicit(p, v, o)      __atomic_store_n((p), (v), (o))
+#define atomic_exchange_explicit(p, v, o)   __atomic_exchange_n((p), (v), (o))
+#define atomic_fetch_add_explicit(p, v, o)  __atomic_fetch_add((p), (v), (o))
+#define atomic_fetch_sub_explicit(p, v, o)  __atomic_fetch_sub((p), (v), (o))
+#define atomic_fetch_or_explicit(p, v, o)   __atomic_fetch_or((p), (v), (o))
+#define atomic_fetch_and_explicit(p, v, o)  __atomic_fetch_and((p), (v), (o))
+#define atomic_compare_exchange_strong_explicit(p, e, d, s, f) \
+    __atomic_compare_exchange_n((p), (e), (d), 0, (s), (f))
+#define atomic_compare_exchange_weak_explicit(p, e, d, s, f) \
+    __atomic_compare_exchange_n((p), (e), (d), 1, (s), (f))
+
+#define atomic_load(p)          atomic_load_explicit((p), memory_order_seq_cst)
+#define atomic_store(p, v)      atomic_store_explicit((p), (v), memory_order_seq_cst)
+#define atomic_exchange(p, v)   atomic_exchange_explicit((p), (v), memory_order_seq_cst)
+#define atomic_fetch_add(p, v)  atomic_fetch_add_explicit((p), (v), memory_order_seq_cst)
+#define atomic_fetch_sub(p, v)  atomic_fetch_sub_explicit((p), (v), memory_order_seq_cst)
+#define atomic_fetch_or(p, v)   atomic_fetch_or_explicit((p), (v), memory_order_seq_cst)
+#define atomic_fetch_and(p, v)  atomic_fetch_and_explicit((p), (v), memory_order_seq_cst)
+#define atomic_compare_exchange_strong(p, e, d) \
+    atomic_compare_exchange_strong_explicit((p), (e), (d), memory_order_seq_cst, memory_order_seq_cst)
+#define atomic_compare_exchange_weak(p, e, d) \
+    atomic_compare_exchange_weak_explicit((p), (e), (d), memory_order_seq_cst, memory_order_seq_cst)
+
+#define atomic_thread_fence(o)  __atomic_thread_fence(o)
+#define atomic_signal_fence(o)  __atomic_signal_fence(o)
+
+static inline void cpu_relax(void) {
+    __builtin_ia32_pause();
+}
+
+// 64-bit operations. i386 has no 64-bit general registers, so these go
+// through lock cmpxchg8b rather than relying on libatomic, which a
+// freestanding build doesn't have.
+#if defined(__i386__)
+
+static inline int atomic_cas_u64(volatile uint64_t* p, uint64_t* expected, uint64_t desired) {
+    uint64_t prev;
+    unsigned char ok;
+    __asm__ volatile (
+        "lock; cmpxchg8b %1\n\t"
+        "sete %2"
+        : "=A"(prev), "+m"(*p), "=q"(ok)
+        : "0"(*expected), "b"((uint32_t)desired), "c"((uint32_t)(desired >> 32))
+        : "memory", "cc"
+    );
+    if (!ok) *expected = prev;
+    return ok;
+}
+
+static inline uint64_t atomic_load_u64(const volatile uint64_t* p) {
+    // cmpxchg8b with edx:eax == ecx:ebx either stores the same value back
+    // or fails; both leave the current value in edx:eax.
+    uint64_t v;
+    __asm__ volatile (
+        "movl %%ebx, %%eax\n\t"
+        "movl %%ecx, %%edx\n\t"
+        "lock; cmpxchg8b %1"
+        : "=&A"(v), "+m"(*(volatile uint64_t*)p)
+        :
+        : "memory", "cc"
+    );
+    return v;
+}
+
+static inline void atomic_store_u64(volatile uint64_t* p, uint64_t v) {
+    uint64_t old = *p;
+    while (!atomic_cas_u64(p, &old, v))
+        ;
+}
+
+static inline uint64_t atomic_fetch_add_u64(volatile uint64_t* p, uint64_t v) {
+    uint64_t old = *p;
+    while (!atomic_cas_u64(p, &old, old + v))
+        ;
+    return old;
+}
+
+#else
+
+static inline int atomic_cas_u64(volatile uint64_t* p, uint64_t* expected, uint64_t desired) {
+    return __atomic_compare_exchange_n(p, expected, desired, 0,
+                                       __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+static inline uint64_t atomic_load_u64(const volatile uint64_t* p) {
+    return __atomic_load_n(p, __ATOMIC_SEQ_CST);
+}
+
+static inline void atomic_store_u64(volatile uint64_t* p, uint64_t v) {
+    __atomic_store_n(p, v, __ATOMIC_SEQ_CST);
+}
+
+static inline uint64_t atomic_fetch_add_u64(volatile uint64_t* p, uint64_t v) {
+    return __atomic_fetch_add(p, v, __ATOMIC_SEQ_CST);
+}
+
+#endif
+
+#endif // STDATOMIC_H
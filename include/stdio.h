@@ -0,0 +1,20 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef STDIO_H
+#define STDIO_H
+
+#include <stdarg.h>
+#include <stddef.h>
+
+int printf(const char* fmt, ...);
+int sprintf(char* buf, const char* fmt, ...);
+int snprintf(char* buf, size_t size, const char* fmt, ...);
+int asprintf(char** strp, const char* fmt, ...);
+int fprintf(void* stream, const char* fmt, ...);
+
+int vprintf(const char* fmt, va_list args);
+int vsprintf(char* buf, const char* fmt, va_list args);
+int vsnprintf(char* buf, size_t size, const char* fmt, va_list args);
+int vasprintf(char** strp, const char* fmt, va_list args);
+
+#endif // STDIO_H
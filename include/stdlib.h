@@ -0,0 +1,35 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef STDLIB_H
+#define STDLIB_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+void* malloc(size_t size);
+void free(void* ptr);
+void* realloc(void* ptr, size_t new_size);
+void* calloc(size_t nmemb, size_t size);
+
+int atoi(const char* str);
+long atol(const char* str);
+long strtol(const char* str, char** endptr, int base);
+double strtod(const char* str, char** endptr);
+
+void qsort(void* base, size_t nmemb, size_t size,
+           int (*compar)(const void*, const void*));
+void* bsearch(const void* key, const void* base, size_t nmemb, size_t size,
+              int (*compar)(const void*, const void*));
+int radix_sort_u32(uint32_t* keys, size_t n);
+int radix_sort_u64(uint64_t* keys, size_t n);
+
+extern char** environ;
+
+char* getenv(const char* name);
+int setenv(const char* name, const char* value, int overwrite);
+int unsetenv(const char* name);
+int putenv(char* string);
+
+void exit(int status);
+
+#endif // STDLIB_H
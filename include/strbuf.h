@@ -0,0 +1,52 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef STRBUF_H
+#define STRBUF_H
+
+#include <stdarg.h>
+#include <stddef.h>
+
+#define SB_INLINE_SIZE 64
+
+// Growable string. Short strings live in the inline buffer and never
+// touch the heap; longer ones grow geometrically, so n appends cost O(n)
+// total. data is always NUL-terminated.
+//
+// A strbuf may point into itself, so don't copy one by value; pass it
+// around by pointer.
+typedef struct {
+    char* data;
+    size_t len;
+    size_t cap;     // bytes available for characters, not counting the NUL
+    char inline_buf[SB_INLINE_SIZE];
+} strbuf;
+
+void sb_init(strbuf* sb);
+void sb_free(strbuf* sb);
+void sb_reset(strbuf* sb);
+int sb_reserve(strbuf* sb, size_t extra);
+
+int sb_appendn(strbuf* sb, const char* s, size_t n);
+int sb_append(strbuf* sb, const char* s);
+int sb_appendc(strbuf* sb, char c);
+int sb_appendf(strbuf* sb, const char* fmt, ...);
+int sb_vappendf(strbuf* sb, const char* fmt, va_list args);
+
+// Hand the string over to the caller, who frees it with free(). Heap
+// contents are returned as-is; inline contents are copied out once.
+// The builder is left empty and ready for reuse.
+char* sb_detach(strbuf* sb, size_t* len);
+
+static inline const char* sb_str(const strbuf* sb) {
+    return sb->data;
+}
+
+// Cut the string back to len characters; never grows it.
+static inline void sb_truncate(strbuf* sb, size_t len) {
+    if (len < sb->len) {
+        sb->len = len;
+        sb->data[len] = '\0';
+    }
+}
+
+#endif // STRBUF_H
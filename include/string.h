@@ -3,8 +3,55 @@
 #ifndef STRING_H
 #define STRING_H
 
+#include <stddef.h>
+
 void* memset(void* ptr, int value, size_t num);
 void* memcpy(void* dest, const void* src, size_t num);
 int memcmp(const void* ptr1, const void* ptr2, size_t num);
 
+size_t strlen(const char* str);
+size_t strnlen(const char* str, size_t maxlen);
+int strcmp(const char* s1, const char* s2);
+char* strchr(const char* str, int c);
+char* strpbrk(const char* str1, const char* str2);
+short strspn(const char* s1, const char* s2);
+short strcspn(const char* s1, const char* s2);
+
+char* strcpy(char* dest, const char* src);
+char* strncpy(char* dest, const char* src, size_t n);
+char* strcat(char* dest, const char* src);
+char* stpcpy(char* dest, const char* src);
+size_t strlcpy(char* dest, const char* src, size_t size);
+
+char* strdup(const char* str);
+char* strndup(const char* str, size_t n);
+
+char* strtok(char* str, const char* delim);
+char* strtok_r(char* str, const char* delim, char** saveptr);
+
+/*
+ * Compile-time fast paths. -ffreestanding stops GCC from treating these
+ * as builtins, so a constant-size memcpy would otherwise be a call.
+ * Small constant sizes go to the builtins, which expand to a few moves;
+ * everything else calls the library. The library's own definitions are
+ * written as (name) so these macros don't touch them. Define
+ * GOLDLIBC_NO_STRING_INLINES to turn this off.
+ */
+#if defined(__GNUC__) && !defined(GOLDLIBC_NO_STRING_INLINES)
+
+#define __STRING_INLINE_MAX 64
+
+#define __string_small(n) (__builtin_constant_p(n) && (n) <= __STRING_INLINE_MAX)
+
+#define memcpy(d, s, n) \
+    (__string_small(n) ? __builtin_memcpy((d), (s), (n)) : (memcpy)((d), (s), (n)))
+#define memset(p, c, n) \
+    (__string_small(n) ? __builtin_memset((p), (c), (n)) : (memset)((p), (c), (n)))
+#define memcmp(a, b, n) \
+    (__string_small(n) ? __builtin_memcmp((a), (b), (n)) : (memcmp)((a), (b), (n)))
+#define strlen(s) \
+    (__builtin_constant_p(s) ? __builtin_strlen(s) : (strlen)(s))
+
+#endif
+
 #endif // STRING_H
@@ -0,0 +1,12 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef SYS_TYPES_H
+#define SYS_TYPES_H
+
+#include <stddef.h>
+
+typedef long ssize_t;
+typedef int pid_t;
+typedef unsigned int mode_t;
+
+#endif // SYS_TYPES_H
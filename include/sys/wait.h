@@ -0,0 +1,19 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef SYS_WAIT_H
+#define SYS_WAIT_H
+
+#include <sys/types.h>
+
+#define WNOHANG 1
+
+// The kernel reports (exit code << 8) | terminating signal.
+#define WEXITSTATUS(s)  (((s) >> 8) & 0xff)
+#define WTERMSIG(s)     ((s) & 0x7f)
+#define WIFEXITED(s)    (WTERMSIG(s) == 0)
+#define WIFSIGNALED(s)  (WTERMSIG(s) != 0)
+
+pid_t waitpid(pid_t pid, int* status, int options);
+pid_t wait(int* status);
+
+#endif // SYS_WAIT_H
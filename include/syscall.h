@@ -0,0 +1,135 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef SYSCALL_H
+#define SYSCALL_H
+
+/* Goldspace syscall numbers */
+#define SYS_OPEN            0
+#define SYS_WRITE           1
+#define SYS_READ            2
+#define SYS_CLOSE           3
+#define SYS_SPAWN           4
+#define SYS_EXIT            6
+#define SYS_STAT            7
+#define SYS_PRINT           8
+#define SYS_THREAD_CREATE   9   /* (entry, stack, tls) -> tid */
+#define SYS_THREAD_EXIT     10  /* (clear_addr): zero and wake *clear_addr once off-stack */
+#define SYS_FUTEX_WAIT      11  /* (addr, val): sleep while *addr == val */
+#define SYS_FUTEX_WAKE      12  /* (addr, count) -> number woken */
+#define SYS_SET_TLS         13  /* (base): set the thread segment base */
+#define SYS_YIELD           14
+#define SYS_CLOCK_GETTIME   15  /* (clock_id, struct timespec *) */
+#define SYS_WAITPID         16  /* (pid, int *status, options) -> pid */
+#define SYS_PIPE            17  /* (int fds[2]) */
+#define SYS_DUP2            18  /* (oldfd, newfd) -> newfd */
+#define SYS_FCNTL           19  /* (fd, cmd, arg) */
+#define SYS_GETDENTS        20  /* (fd, buf, size) -> bytes of struct dirent records, 0 at end */
+#define SYS_NPROCS          21  /* () -> number of CPUs available to this process */
+#define SYS_MAX             22  /* one past the highest number; bump when adding one */
+
+#if defined(GOLDLIBC_HOSTED)
+
+/*
+ * Hosted builds (the test harness under tests/) run on a normal Linux
+ * host, which supplies __hosted_syscall to map these numbers onto its
+ * own syscalls.
+ */
+long __hosted_syscall(long n, long a, long b, long c);
+
+static inline long __syscall0(long n) {
+    return __hosted_syscall(n, 0, 0, 0);
+}
+
+static inline long __syscall1(long n, long a) {
+    return __hosted_syscall(n, a, 0, 0);
+}
+
+static inline long __syscall2(long n, long a, long b) {
+    return __hosted_syscall(n, a, b, 0);
+}
+
+static inline long __syscall3(long n, long a, long b, long c) {
+    return __hosted_syscall(n, a, b, c);
+}
+
+#elif defined(__x86_64__)
+
+/*
+ * Raw syscall helpers. x86-64 uses the syscall instruction: number in
+ * rax, arguments in rdi, rsi, rdx; rcx and r11 are clobbered.
+ */
+static inline long __syscall0(long n) {
+    long ret;
+    __asm__ volatile ("syscall" : "=a"(ret) : "a"(n) : "rcx", "r11", "memory");
+    return ret;
+}
+
+static inline long __syscall1(long n, long a) {
+    long ret;
+    __asm__ volatile ("syscall" : "=a"(ret) : "a"(n), "D"(a) : "rcx", "r11", "memory");
+    return ret;
+}
+
+static inline long __syscall2(long n, long a, long b) {
+    long ret;
+    __asm__ volatile ("syscall" : "=a"(ret) : "a"(n), "D"(a), "S"(b) : "rcx", "r11", "memory");
+    return ret;
+}
+
+static inline long __syscall3(long n, long a, long b, long c) {
+    long ret;
+    __asm__ volatile ("syscall" : "=a"(ret) : "a"(n), "D"(a), "S"(b), "d"(c) : "rcx", "r11", "memory");
+    return ret;
+}
+
+#else
+
+/*
+ * Raw syscall helpers. i386 traps through int $0x80: number in eax,
+ * arguments in ebx, ecx, edx, result back in eax.
+ */
+static inline long __syscall0(long n) {
+    long ret;
+    __asm__ volatile ("int $0x80" : "=a"(ret) : "a"(n) : "memory");
+    return ret;
+}
+
+static inline long __syscall1(long n, long a) {
+    long ret;
+    __asm__ volatile ("int $0x80" : "=a"(ret) : "a"(n), "b"(a) : "memory");
+    return ret;
+}
+
+static inline long __syscall2(long n, long a, long b) {
+    long ret;
+    __asm__ volatile ("int $0x80" : "=a"(ret) : "a"(n), "b"(a), "c"(b) : "memory");
+    return ret;
+}
+
+static inline long __syscall3(long n, long a, long b, long c) {
+    long ret;
+    __asm__ volatile ("int $0x80" : "=a"(ret) : "a"(n), "b"(a), "c"(b), "d"(c) : "memory");
+    return ret;
+}
+
+#endif
+
+#ifdef GOLDLIBC_PROFILE
+#include <prof.h>
+
+/*
+ * Profiled builds route every wrapper through the counters. The
+ * parenthesised name reaches the raw helper, which is also how the
+ * profiler itself prints without counting its own output.
+ */
+#define __syscall0(n) \
+    ({ PROF_START(__t); long __r = (__syscall0)(n); __prof_syscall((n), __r, __t); __r; })
+#define __syscall1(n, a) \
+    ({ PROF_START(__t); long __r = (__syscall1)((n), (a)); __prof_syscall((n), __r, __t); __r; })
+#define __syscall2(n, a, b) \
+    ({ PROF_START(__t); long __r = (__syscall2)((n), (a), (b)); __prof_syscall((n), __r, __t); __r; })
+#define __syscall3(n, a, b, c) \
+    ({ PROF_START(__t); long __r = (__syscall3)((n), (a), (b), (c)); __prof_syscall((n), __r, __t); __r; })
+#endif
+
+#endif // SYSCALL_H
@@ -0,0 +1,59 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef TASK_H
+#define TASK_H
+
+#include <stddef.h>
+#include <stdatomic.h>
+
+#define TASK_DEFAULT_WORKERS 4    // when the CPU count is unavailable
+#define TASK_MAX_WORKERS     64
+#define TASK_DEQUE_SIZE      4096
+
+// A unit of work. Tasks are owned by whoever spawned them (usually on
+// the spawner's stack) and must stay alive until *pending drops back.
+typedef struct task {
+    void (*fn)(struct task* t);
+    atomic_int* pending;
+} task_t;
+
+// Chase-Lev work-stealing deque. The owner pushes and pops at the
+// bottom without contention; thieves take from the top with one CAS.
+typedef struct {
+    atomic_long top;
+    char pad0[64 - sizeof(long)];
+    atomic_long bottom;
+    char pad1[64 - sizeof(long)];
+    atomic_uintptr_t slots[TASK_DEQUE_SIZE];
+} task_deque;
+
+void task_deque_init(task_deque* d);
+int task_deque_push(task_deque* d, task_t* t);     // -1 if full
+task_t* task_deque_pop(task_deque* d);
+task_t* task_deque_steal(task_deque* d);
+
+// Worker pool. task_pool_init() is optional; the first parallel call
+// calls task_pool_init(0) if nobody did it earlier. nworkers 0 means one
+// worker per CPU, or TASK_DEFAULT_WORKERS if the kernel can't say. The
+// thread that initializes the pool takes part in the work as well.
+int task_pool_init(int nworkers);
+void task_pool_shutdown(void);
+int task_pool_size(void);
+
+// A thread outside the pool has no deque to push to, so its spawns run
+// inline, one after another, before task_spawn() returns; only work
+// spawned from inside the pool (the initializing thread included) runs
+// in parallel. task_wait() helps with queued work, then sleeps until the
+// last task of the group finishes.
+void task_spawn(task_t* t, atomic_int* pending);
+void task_wait(atomic_int* pending);
+
+// fn is called on disjoint subranges of [begin, end), each at most
+// roughly grain elements long.
+void parallel_for(size_t begin, size_t end, size_t grain,
+                  void (*fn)(size_t begin, size_t end, void* ctx), void* ctx);
+
+void parallel_qsort(void* base, size_t nmemb, size_t size,
+                    int (*compar)(const void*, const void*));
+
+#endif // TASK_H
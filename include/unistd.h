@@ -0,0 +1,27 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef UNISTD_H
+#define UNISTD_H
+
+#include <stddef.h>
+#include <sys/types.h>
+
+#define STDIN_FILENO  0
+#define STDOUT_FILENO 1
+#define STDERR_FILENO 2
+
+#define _SC_NPROCESSORS_ONLN 84
+
+ssize_t read(int fd, void* buf, size_t size);
+ssize_t write(int fd, const void* buf, size_t size);
+int close(int fd);
+int pipe(int fds[2]);
+int dup(int fd);
+int dup2(int oldfd, int newfd);
+
+long sysconf(int name);
+
+pid_t spawn(const char* path, char* const argv[]);
+void _exit(int status);
+
+#endif // UNISTD_H
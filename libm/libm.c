@@ -20,7 +20,14 @@ static const double INV_LN2 = 1.442695040888963407359924681001892137; /* 1/ln2 *
 
 /* Basic helpers */
 double fabs(double x) {
+#if defined(__x86_64__)
+    /* clear the sign bit; no branch, and handles -0.0 */
+    union { double d; uint64_t u; } v = { x };
+    v.u &= ~(1ULL << 63);
+    return v.d;
+#else
     return x < 0.0 ? -x : x;
+#endif
 }
 
 /* floor/ceil: simple, reasonable range, avoids heavy FP intrinsics */
@@ -37,19 +44,29 @@ double ceil(double x) {
     return (double)t;
 }
 
-/* fmod: remainder with sign of dividend (like fmod from C) */
+/* fmod: remainder with sign of dividend (like fmod from C). Exact:
+   subtracts y scaled by powers of two, each step without rounding. */
 double fmod(double x, double y) {
-    if (y == 0.0) return 0.0/0.0; /* NaN */
-    double q = (double)((long long)(x / y)); /* crude quotient */
-    double r = x - q * y;
-    /* adjust until |r| < |y| */
-    while (r >= y) r -= y;
-    while (r <= -y) r += y;
-    return r;
+    if (y == 0.0 || x != x || y != y || x - x != 0.0) return 0.0/0.0; /* NaN */
+    double ax = x < 0 ? -x : x;
+    double ay = y < 0 ? -y : y;
+    if (ax < ay) return x;
+
+    double t = ay;
+    while (t <= ax * 0.5) t *= 2.0;
+    while (t >= ay) {
+        if (ax >= t) ax -= t;
+        t *= 0.5;
+    }
+    return x < 0 ? -ax : ax;
 }
 
-/* sqrt: Newton-Raphson with a few iterations */
+/* sqrt: sqrtsd where SSE2 is baseline (x86-64), Newton-Raphson otherwise */
 double sqrt(double x) {
+#if defined(__SSE2__)
+    __asm__ ("sqrtsd %1, %0" : "=x"(x) : "x"(x));
+    return x;
+#endif
     if (x <= 0.0) return x == 0.0 ? 0.0 : 0.0/0.0; /* handle negative -> NaN */
     /* initial guess: use exponent approximation */
     int exp = (int)(0);
@@ -67,6 +84,15 @@ double sqrt(double x) {
     return g;
 }
 
+/* x * 2^n by building the power of two from its exponent bits */
+static double scale2(double x, int n) {
+    union { double d; uint64_t u; } p;
+    while (n > 1023) { x *= 0x1p1023; n -= 1023; }
+    while (n < -1022) { x *= 0x1p-1022; n += 1022; }
+    p.u = (uint64_t)(n + 1023) << 52;
+    return x * p.d;
+}
+
 /* exp: range reduction + polynomial */
 double exp(double x) {
     if (x > 700.0) return 1.0/0.0;  /* overflow -> inf */
@@ -88,8 +114,8 @@ double exp(double x) {
     double res = 1.0 + r + r2*0.5 + r3*(1.0/6.0) + r4*(1.0/24.0)
                  + r5*(1.0/120.0) + r6*(1.0/720.0) + r7*(1.0/5040.0);
 
-    /* scale by 2^n using builtin (no external ldexp dependency) */
-    return __builtin_ldexp(res, n);
+    /* scale by 2^n; __builtin_ldexp would call an ldexp we don't have */
+    return scale2(res, n);
 }
 
 double log(double x) {
@@ -9,6 +9,9 @@
  */
 
 #include <stddef.h>
+#include <sys/types.h>
+#include <syscall.h>
+#include <fcntl.h>
 
 struct stat {
     size_t st_size;  // File size in bytes
@@ -18,77 +21,37 @@ struct stat {
 };
 
 int open(const char *path, int flags) {
-    int fd;
-    __asm__ volatile (
-        "movl $0, %%eax\n\t"    // syscall number for open
-        "movl %1, %%ebx\n\t"    // path
-        "movl %2, %%ecx\n\t"    // flags
-        "int $0x80\n\t"         // syscall
-        "movl %%eax, %0\n\t"    // store return in fd
-        : "=r"(fd)
-        : "r"(path), "r"(flags)
-        : "%eax", "%ebx", "%ecx"
-    );
-    return fd;
+    return (int)__syscall2(SYS_OPEN, (long)path, flags);
 }
 
 ssize_t read(int fd, void *buf, size_t size) {
-    ssize_t ret;
-    __asm__ volatile (
-        "movl $2, %%eax\n\t"    // syscall number for read
-        "movl %1, %%ebx\n\t"    // fd
-        "movl %2, %%ecx\n\t"    // buf
-        "movl %3, %%edx\n\t"    // size
-        "int $0x80\n\t"
-        "movl %%eax, %0\n\t"
-        : "=r"(ret)
-        : "r"(fd), "r"(buf), "r"(size)
-        : "%eax", "%ebx", "%ecx", "%edx"
-    );
-    return ret;
+    return (ssize_t)__syscall3(SYS_READ, fd, (long)buf, (long)size);
 }
 
 ssize_t write(int fd, const void *buf, size_t size) {
-    ssize_t ret;
-    __asm__ volatile (
-        "movl $1, %%eax\n\t"    // syscall number for write
-        "movl %1, %%ebx\n\t"    // fd
-        "movl %2, %%ecx\n\t"    // buf
-        "movl %3, %%edx\n\t"    // size
-        "int $0x80\n\t"
-        "movl %%eax, %0\n\t"
-        : "=r"(ret)
-        : "r"(fd), "r"(buf), "r"(size)
-        : "%eax", "%ebx", "%ecx", "%edx"
-    );
-    return ret;
+    return (ssize_t)__syscall3(SYS_WRITE, fd, (long)buf, (long)size);
 }
 
 int close(int fd) {
-    int ret;
-    __asm__ volatile (
-        "movl $3, %%eax\n\t"    // syscall number for close
-        "movl %1, %%ebx\n\t"    // fd
-        "int $0x80\n\t"
-        "movl %%eax, %0\n\t"
-        : "=r"(ret)
-        : "r"(fd)
-        : "%eax", "%ebx"
-    );
-    return ret;
+    return (int)__syscall1(SYS_CLOSE, fd);
 }
 
 int stat(const char *path, struct stat *st) {
-    int ret;
-    __asm__ volatile (
-        "movl $7, %%eax\n\t"    // syscall number for stat
-        "movl %1, %%ebx\n\t"    // path
-        "movl %2, %%ecx\n\t"    // struct stat pointer
-        "int $0x80\n\t"
-        "movl %%eax, %0\n\t"
-        : "=r"(ret)
-        : "r"(path), "r"(st)
-        : "%eax", "%ebx", "%ecx"
-    );
-    return ret;
+    return (int)__syscall2(SYS_STAT, (long)path, (long)st);
+}
+
+int pipe(int fds[2]) {
+    return (int)__syscall1(SYS_PIPE, (long)fds);
+}
+
+int fcntl(int fd, int cmd, int arg) {
+    return (int)__syscall3(SYS_FCNTL, fd, cmd, arg);
+}
+
+int dup(int fd) {
+    return fcntl(fd, F_DUPFD, 0);
+}
+
+int dup2(int oldfd, int newfd) {
+    return (int)__syscall2(SYS_DUP2, oldfd, newfd);
 }
@@ -10,32 +10,33 @@
 
 #include <stdarg.h>
 #include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <syscall.h>
+#include <format.h>
+#include <strbuf.h>
+#include <prof.h>
 
 // --------------------------------------------------
-// Helper: convert number to string
+// Helper: convert number to string. Base 10 is signed; other bases
+// print the bits as unsigned, as %x does.
 // --------------------------------------------------
 static void num_to_str(int num, int base, char *buf) {
     char tmp[32];
     char *ptr = tmp + sizeof(tmp) - 1;
-    int is_negative = 0;
+    int is_negative = base == 10 && num < 0;
+    // Negate in unsigned arithmetic so INT_MIN doesn't overflow
+    unsigned int n = is_negative ? 0u - (unsigned int)num : (unsigned int)num;
 
     *ptr = '\0';
 
-    if (num == 0) {
-        *(--ptr) = '0';
-    } else {
-        if (base == 10 && num < 0) {
-            is_negative = 1;
-            num = -num;
-        }
-        while (num) {
-            int digit = num % base;
-            *(--ptr) = digit < 10 ? '0' + digit : 'a' + (digit - 10);
-            num /= base;
-        }
-        if (is_negative) {
-            *(--ptr) = '-';
-        }
+    do {
+        unsigned int digit = n % base;
+        *(--ptr) = digit < 10 ? '0' + digit : 'a' + (digit - 10);
+        n /= base;
+    } while (n);
+    if (is_negative) {
+        *(--ptr) = '-';
     }
 
     // Copy result to output buffer
@@ -47,74 +48,140 @@ static void num_to_str(int num, int base, char *buf) {
 }
 
 // --------------------------------------------------
-// vsprintf: write formatted output to a buffer
+// __vformat: the formatting engine. Output goes out in chunks through
+// put(), so the same code serves fixed buffers, bounded buffers and
+// growable string builders.
 // --------------------------------------------------
-int vsprintf(char *buf, const char *fmt, va_list args) {
-    char *out = buf;
-
-    for (const char *p = fmt; *p; ++p) {
-        if (*p == '%') {
-            ++p;
-            if (!*p) break;
-
-            switch (*p) {
-                case 's': {
-                    char *s = va_arg(args, char *);
-                    while (*s) *out++ = *s++;
-                    break;
-                }
-                case 'd': {
-                    int n = va_arg(args, int);
-                    char numbuf[32];
-                    num_to_str(n, 10, numbuf);
-                    char *s = numbuf;
-                    while (*s) *out++ = *s++;
-                    break;
-                }
-                case 'x': {
-                    int n = va_arg(args, int);
-                    char numbuf[32];
-                    num_to_str(n, 16, numbuf);
-                    char *s = numbuf;
-                    while (*s) *out++ = *s++;
-                    break;
-                }
-                case 'c': {
-                    char c = (char)va_arg(args, int);
-                    *out++ = c;
-                    break;
-                }
-                default:
-                    *out++ = *p;
-                    break;
+int __vformat(format_put put, void *ctx, const char *fmt, va_list args) {
+    int total = 0;
+    const char *p = fmt;
+
+    while (*p) {
+        // Literal run up to the next conversion
+        const char *run = p;
+        while (*p && *p != '%') p++;
+        if (p != run) {
+            put(ctx, run, p - run);
+            total += p - run;
+        }
+        if (!*p) break;
+
+        ++p;
+        if (!*p) break;
+
+        switch (*p) {
+            case 's': {
+                char *s = va_arg(args, char *);
+                size_t n = strlen(s);
+                put(ctx, s, n);
+                total += n;
+                break;
+            }
+            case 'd': {
+                int n = va_arg(args, int);
+                char numbuf[32];
+                num_to_str(n, 10, numbuf);
+                size_t len = strlen(numbuf);
+                put(ctx, numbuf, len);
+                total += len;
+                break;
+            }
+            case 'x': {
+                int n = va_arg(args, int);
+                char numbuf[32];
+                num_to_str(n, 16, numbuf);
+                size_t len = strlen(numbuf);
+                put(ctx, numbuf, len);
+                total += len;
+                break;
             }
-        } else {
-            *out++ = *p;
+            case 'c': {
+                char c = (char)va_arg(args, int);
+                put(ctx, &c, 1);
+                total++;
+                break;
+            }
+            default:
+                put(ctx, p, 1);
+                total++;
+                break;
         }
+        ++p;
     }
 
-    *out = '\0';
-    return out - buf; // number of chars written
+    return total;
+}
+
+// Sink for a plain buffer; left bounds the copy, keeping room for the NUL.
+struct buf_sink {
+    char *out;
+    size_t left;
+};
+
+static void buf_put(void *ctx, const char *s, size_t n) {
+    struct buf_sink *b = ctx;
+    if (n > b->left) n = b->left;
+    memcpy(b->out, s, n);
+    b->out += n;
+    b->left -= n;
+}
+
+// --------------------------------------------------
+// vsprintf: write formatted output to a buffer
+// --------------------------------------------------
+int vsprintf(char *buf, const char *fmt, va_list args) {
+    struct buf_sink b = { buf, (size_t)-1 };
+    int ret = __vformat(buf_put, &b, fmt, args);
+    *b.out = '\0';
+    return ret; // number of chars written
+}
+
+// --------------------------------------------------
+// vsnprintf: bounded; returns the length the full output would have
+// --------------------------------------------------
+int vsnprintf(char *buf, size_t size, const char *fmt, va_list args) {
+    if (size == 0) {
+        struct buf_sink b = { NULL, 0 };
+        return __vformat(buf_put, &b, fmt, args);
+    }
+    struct buf_sink b = { buf, size - 1 };
+    int ret = __vformat(buf_put, &b, fmt, args);
+    *b.out = '\0';
+    return ret;
 }
 
 // --------------------------------------------------
-// vprintf: write formatted output to the screen via syscall
+// vprintf: write formatted output to the screen via syscall; returns
+// the number of characters written, which stops at the buffer size
 // --------------------------------------------------
 int vprintf(const char *fmt, va_list args) {
+    PROF_START(t0);
     char buf[512]; // temporary buffer
-    vsprintf(buf, fmt, args);
+    int len = vsnprintf(buf, sizeof(buf), fmt, args);
+    if (len < 0) return len;
+    if (len > (int)sizeof(buf) - 1) len = (int)sizeof(buf) - 1;
 
     // Output using syscall #8 (like puts)
-    asm volatile (
-        "mov %[str], %%ebx;"
-        "mov $8, %%eax;"
-        "int $0x80;"
-        :
-        : [str] "r"(buf)
-        : "%eax", "%ebx"
-    );
-
-    return 0; // in the future, could return number of chars written
+    __syscall1(SYS_PRINT, (long)buf);
+    PROF_STOP(PROF_PRINTF, t0, len);
+
+    return len;
+}
+
+// --------------------------------------------------
+// vasprintf: format into a freshly malloc'd string
+// --------------------------------------------------
+int vasprintf(char **strp, const char *fmt, va_list args) {
+    strbuf sb;
+    sb_init(&sb);
+    if (sb_vappendf(&sb, fmt, args) < 0) {
+        sb_free(&sb);
+        *strp = NULL;
+        return -1;
+    }
+    size_t len;
+    *strp = sb_detach(&sb, &len);
+    return *strp ? (int)len : -1;
 }
 
 // --------------------------------------------------
@@ -139,15 +206,22 @@ int sprintf(char *buf, const char *fmt, ...) {
 int snprintf(char *buf, size_t size, const char *fmt, ...) {
     va_list args;
     va_start(args, fmt);
-    int written = vsprintf(buf, fmt, args);
-    if ((size_t)written >= size) {
-        buf[size - 1] = '\0';
+    int written = vsnprintf(buf, size, fmt, args);
+    if (size && (size_t)written >= size) {
         written = size - 1;
     }
     va_end(args);
     return written;
 }
 
+int asprintf(char **strp, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    int ret = vasprintf(strp, fmt, args);
+    va_end(args);
+    return ret;
+}
+
 int fprintf(void *stream, const char *fmt, ...) {
     va_list args;
     va_start(args, fmt);
@@ -0,0 +1,423 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * stdlib/checksum.c
+ * 
+ * Checksums: CRC32, CRC32C, Adler-32 and xxHash64. The CRCs and Adler-32
+ * pick SSE4.2 / PCLMULQDQ / SSE2 kernels at first use via CPUID and fall
+ * back to portable table-driven code.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <cpuid.h>
+#include <immintrin.h>
+#include <pthread.h>
+#include <checksum.h>
+
+#define POLY_CRC32   0xedb88320u   // reflected 0x04c11db7
+#define POLY_CRC32C  0x82f63b78u   // reflected 0x1edc6f41 (Castagnoli)
+
+#define ADLER_BASE 65521u
+#define ADLER_NMAX 5552     // most bytes before s2 can overflow 32 bits
+
+typedef uint32_t (*crc_fn)(uint32_t state, const uint8_t* p, size_t len);
+typedef uint32_t (*adler_fn)(uint32_t adler, const uint8_t* p, size_t len);
+
+static uint32_t crc32_table[8][256];
+static uint32_t crc32c_table[8][256];
+
+static crc_fn crc32_impl;
+static crc_fn crc32c_impl;
+static adler_fn adler32_impl;
+
+static pthread_once_t dispatch_once = PTHREAD_ONCE_INIT;
+
+static inline uint32_t read32(const uint8_t* p) {
+    uint32_t v;
+    __builtin_memcpy(&v, p, 4);
+    return v;
+}
+
+static inline uint64_t read64(const uint8_t* p) {
+    uint64_t v;
+    __builtin_memcpy(&v, p, 8);
+    return v;
+}
+
+// --------------------------------------------------
+// Portable CRC: slicing-by-8
+// --------------------------------------------------
+// CRC kernels work on the raw shift-register state; the public
+// functions do the pre/post inversion.
+static void make_table(uint32_t table[8][256], uint32_t poly) {
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k)
+            c = c & 1 ? (c >> 1) ^ poly : c >> 1;
+        table[0][i] = c;
+    }
+    for (uint32_t i = 0; i < 256; ++i)
+        for (int t = 1; t < 8; ++t)
+            table[t][i] = (table[t - 1][i] >> 8) ^ table[0][table[t - 1][i] & 0xff];
+}
+
+static inline uint32_t crc_slice8(uint32_t table[8][256], uint32_t s, const uint8_t* p, size_t len) {
+    while (len && ((uintptr_t)p & 7)) {
+        s = (s >> 8) ^ table[0][(s ^ *p++) & 0xff];
+        len--;
+    }
+    while (len >= 8) {
+        uint32_t a = read32(p) ^ s;
+        uint32_t b = read32(p + 4);
+        s = table[7][a & 0xff] ^ table[6][(a >> 8) & 0xff] ^
+            table[5][(a >> 16) & 0xff] ^ table[4][a >> 24] ^
+            table[3][b & 0xff] ^ table[2][(b >> 8) & 0xff] ^
+            table[1][(b >> 16) & 0xff] ^ table[0][b >> 24];
+        p += 8;
+        len -= 8;
+    }
+    while (len--)
+        s = (s >> 8) ^ table[0][(s ^ *p++) & 0xff];
+    return s;
+}
+
+static uint32_t crc32_sw(uint32_t s, const uint8_t* p, size_t len) {
+    return crc_slice8(crc32_table, s, p, len);
+}
+
+static uint32_t crc32c_sw(uint32_t s, const uint8_t* p, size_t len) {
+    return crc_slice8(crc32c_table, s, p, len);
+}
+
+// --------------------------------------------------
+// CRC32C with the SSE4.2 crc32 instruction
+// --------------------------------------------------
+// The instruction has a 3-cycle latency but issues every cycle, so one
+// dependency chain leaves two thirds of the unit idle. Three blocks are
+// run as independent streams and stitched together afterwards by
+// shifting the earlier states forward over the later blocks, which is a
+// multiply by x^(8*block) mod P.
+#define LONG_BLOCK  2048
+#define SHORT_BLOCK 256
+
+static uint32_t crc32c_long_shift;
+static uint32_t crc32c_short_shift;
+
+// a * b mod P, both reflected (bit 31 = x^0).
+static uint32_t multmodp(uint32_t a, uint32_t b, uint32_t poly) {
+    uint32_t m = 1u << 31, p = 0;
+    for (;;) {
+        if (a & m) {
+            p ^= b;
+            if ((a & (m - 1)) == 0) break;
+        }
+        m >>= 1;
+        b = b & 1 ? (b >> 1) ^ poly : b >> 1;
+    }
+    return p;
+}
+
+// x^(8 * n) mod P
+static uint32_t x8nmodp(size_t n, uint32_t poly) {
+    uint32_t sq = 1u << 23;    // x^8
+    uint32_t p = 1u << 31;     // x^0
+    while (n) {
+        if (n & 1) p = multmodp(sq, p, poly);
+        sq = multmodp(sq, sq, poly);
+        n >>= 1;
+    }
+    return p;
+}
+
+#if defined(__x86_64__)
+#define CRC_WORD uint64_t
+#define crc_word(s, p) ((uint32_t)_mm_crc32_u64((s), read64(p)))
+#else
+#define CRC_WORD uint32_t
+#define crc_word(s, p) _mm_crc32_u32((s), read32(p))
+#endif
+
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_hw_block3(uint32_t s, const uint8_t* p, size_t block, uint32_t shift) {
+    const uint8_t* end = p + block;
+    uint32_t s1 = 0, s2 = 0;
+    while (p < end) {
+        s = crc_word(s, p);
+        s1 = crc_word(s1, p + block);
+        s2 = crc_word(s2, p + 2 * block);
+        p += sizeof(CRC_WORD);
+    }
+    s = multmodp(shift, s, POLY_CRC32C) ^ s1;
+    return multmodp(shift, s, POLY_CRC32C) ^ s2;
+}
+
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_hw(uint32_t s, const uint8_t* p, size_t len) {
+    while (len && ((uintptr_t)p & (sizeof(CRC_WORD) - 1))) {
+        s = _mm_crc32_u8(s, *p++);
+        len--;
+    }
+    while (len >= 3 * LONG_BLOCK) {
+        s = crc32c_hw_block3(s, p, LONG_BLOCK, crc32c_long_shift);
+        p += 3 * LONG_BLOCK;
+        len -= 3 * LONG_BLOCK;
+    }
+    while (len >= 3 * SHORT_BLOCK) {
+        s = crc32c_hw_block3(s, p, SHORT_BLOCK, crc32c_short_shift);
+        p += 3 * SHORT_BLOCK;
+        len -= 3 * SHORT_BLOCK;
+    }
+    while (len >= sizeof(CRC_WORD)) {
+        s = crc_word(s, p);
+        p += sizeof(CRC_WORD);
+        len -= sizeof(CRC_WORD);
+    }
+    while (len--)
+        s = _mm_crc32_u8(s, *p++);
+    return s;
+}
+
+// --------------------------------------------------
+// CRC32 by carry-less multiplication folding
+// --------------------------------------------------
+// Four 128-bit accumulators are folded forward 64 bytes at a time, then
+// folded into one, reduced to 64 and 32 bits and finished with a Barrett
+// reduction. Constants are x^k mod P for the reflected polynomial (see
+// Intel's "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ").
+static inline __attribute__((target("pclmul,sse2")))
+__m128i fold16(__m128i x, __m128i k, __m128i data) {
+    __m128i lo = _mm_clmulepi64_si128(x, k, 0x00);
+    __m128i hi = _mm_clmulepi64_si128(x, k, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(lo, hi), data);
+}
+
+// len must be >= 64 and a multiple of 16.
+__attribute__((target("pclmul,sse2")))
+static uint32_t crc32_fold(uint32_t s, const uint8_t* p, size_t len) {
+    const __m128i k1k2 = _mm_set_epi32(0x00000001, 0xc6e41596, 0x00000001, 0x54442bd4);
+    const __m128i k3k4 = _mm_set_epi32(0x00000000, 0xccaa009e, 0x00000001, 0x751997d0);
+    const __m128i k5   = _mm_set_epi32(0x00000000, 0x00000000, 0x00000001, 0x63cd6124);
+    const __m128i pu   = _mm_set_epi32(0x00000001, 0xf7011641, 0x00000001, 0xdb710641);
+    const __m128i mask32 = _mm_set_epi32(0, 0, 0, -1);
+
+    __m128i x1 = _mm_loadu_si128((const __m128i*)p);
+    __m128i x2 = _mm_loadu_si128((const __m128i*)(p + 16));
+    __m128i x3 = _mm_loadu_si128((const __m128i*)(p + 32));
+    __m128i x4 = _mm_loadu_si128((const __m128i*)(p + 48));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)s));
+    p += 64;
+    len -= 64;
+
+    while (len >= 64) {
+        x1 = fold16(x1, k1k2, _mm_loadu_si128((const __m128i*)p));
+        x2 = fold16(x2, k1k2, _mm_loadu_si128((const __m128i*)(p + 16)));
+        x3 = fold16(x3, k1k2, _mm_loadu_si128((const __m128i*)(p + 32)));
+        x4 = fold16(x4, k1k2, _mm_loadu_si128((const __m128i*)(p + 48)));
+        p += 64;
+        len -= 64;
+    }
+
+    x1 = fold16(x1, k3k4, x2);
+    x1 = fold16(x1, k3k4, x3);
+    x1 = fold16(x1, k3k4, x4);
+    while (len >= 16) {
+        x1 = fold16(x1, k3k4, _mm_loadu_si128((const __m128i*)p));
+        p += 16;
+        len -= 16;
+    }
+
+    // 128 -> 64 bits
+    __m128i t = _mm_clmulepi64_si128(k3k4, x1, 0x01);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), t);
+
+    // 64 -> 32 bits
+    t = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k5, 0x00);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 4), t);
+
+    // Barrett reduction
+    t = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), pu, 0x10);
+    t = _mm_clmulepi64_si128(_mm_and_si128(t, mask32), pu, 0x00);
+    x1 = _mm_xor_si128(x1, t);
+    return (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(x1, 4));
+}
+
+static uint32_t crc32_pclmul(uint32_t s, const uint8_t* p, size_t len) {
+    if (len >= 64) {
+        size_t n = len & ~(size_t)15;
+        s = crc32_fold(s, p, n);
+        p += n;
+        len -= n;
+    }
+    return crc32_sw(s, p, len);
+}
+
+// --------------------------------------------------
+// Adler-32
+// --------------------------------------------------
+static uint32_t adler32_sw(uint32_t adler, const uint8_t* p, size_t len) {
+    uint32_t s1 = adler & 0xffff, s2 = adler >> 16;
+    while (len) {
+        size_t n = len < ADLER_NMAX ? len : ADLER_NMAX;
+        len -= n;
+        while (n--) {
+            s1 += *p++;
+            s2 += s1;
+        }
+        s1 %= ADLER_BASE;
+        s2 %= ADLER_BASE;
+    }
+    return (s2 << 16) | s1;
+}
+
+static inline __attribute__((target("sse2")))
+uint32_t hsum32(__m128i v) {
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return (uint32_t)_mm_cvtsi128_si32(v);
+}
+
+// 16 bytes per step: psadbw sums the bytes for s1, and pmaddwd against
+// the weights 16..1 gives each byte's contribution to s2. The s1 values
+// seen at the start of each block are summed separately and added to s2
+// times 16 at the end of each NMAX run.
+__attribute__((target("sse2")))
+static uint32_t adler32_sse2(uint32_t adler, const uint8_t* p, size_t len) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i w_lo = _mm_set_epi16(9, 10, 11, 12, 13, 14, 15, 16);
+    const __m128i w_hi = _mm_set_epi16(1, 2, 3, 4, 5, 6, 7, 8);
+    uint32_t s1 = adler & 0xffff, s2 = adler >> 16;
+
+    while (len >= 16) {
+        size_t n = (len < ADLER_NMAX ? len : ADLER_NMAX) & ~(size_t)15;
+        len -= n;
+
+        __m128i vs1 = _mm_cvtsi32_si128((int)s1);
+        __m128i vs2 = _mm_cvtsi32_si128((int)s2);
+        __m128i vps = zero;
+
+        for (; n; n -= 16, p += 16) {
+            __m128i v = _mm_loadu_si128((const __m128i*)p);
+            vps = _mm_add_epi32(vps, vs1);
+            vs1 = _mm_add_epi32(vs1, _mm_sad_epu8(v, zero));
+            vs2 = _mm_add_epi32(vs2, _mm_madd_epi16(_mm_unpacklo_epi8(v, zero), w_lo));
+            vs2 = _mm_add_epi32(vs2, _mm_madd_epi16(_mm_unpackhi_epi8(v, zero), w_hi));
+        }
+        vs2 = _mm_add_epi32(vs2, _mm_slli_epi32(vps, 4));
+
+        s1 = hsum32(vs1) % ADLER_BASE;
+        s2 = hsum32(vs2) % ADLER_BASE;
+    }
+    return adler32_sw((s2 << 16) | s1, p, len);
+}
+
+// --------------------------------------------------
+// Dispatch
+// --------------------------------------------------
+static void init_dispatch(void) {
+    unsigned int eax, ebx, ecx = 0, edx = 0;
+
+    make_table(crc32_table, POLY_CRC32);
+    make_table(crc32c_table, POLY_CRC32C);
+    crc32c_long_shift = x8nmodp(LONG_BLOCK, POLY_CRC32C);
+    crc32c_short_shift = x8nmodp(SHORT_BLOCK, POLY_CRC32C);
+
+    __get_cpuid(1, &eax, &ebx, &ecx, &edx);
+
+    crc32_impl = (ecx & bit_PCLMUL) && (edx & bit_SSE2) ? crc32_pclmul : crc32_sw;
+    crc32c_impl = (ecx & bit_SSE4_2) ? crc32c_hw : crc32c_sw;
+    adler32_impl = (edx & bit_SSE2) ? adler32_sse2 : adler32_sw;
+}
+
+uint32_t crc32(uint32_t crc, const void* buf, size_t len) {
+    pthread_once(&dispatch_once, init_dispatch);
+    return ~crc32_impl(~crc, buf, len);
+}
+
+uint32_t crc32c(uint32_t crc, const void* buf, size_t len) {
+    pthread_once(&dispatch_once, init_dispatch);
+    return ~crc32c_impl(~crc, buf, len);
+}
+
+uint32_t adler32(uint32_t adler, const void* buf, size_t len) {
+    pthread_once(&dispatch_once, init_dispatch);
+    return adler32_impl(adler, buf, len);
+}
+
+// --------------------------------------------------
+// xxHash64
+// --------------------------------------------------
+#define XXH_P1 0x9e3779b185ebca87ull
+#define XXH_P2 0xc2b2ae3d27d4eb4full
+#define XXH_P3 0x165667b19e3779f9ull
+#define XXH_P4 0x85ebca77c2b2ae63ull
+#define XXH_P5 0x27d4eb2f165667c5ull
+
+static inline uint64_t rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t xxh_round(uint64_t acc, uint64_t in) {
+    acc += in * XXH_P2;
+    acc = rotl64(acc, 31);
+    return acc * XXH_P1;
+}
+
+static inline uint64_t xxh_merge(uint64_t acc, uint64_t v) {
+    acc ^= xxh_round(0, v);
+    return acc * XXH_P1 + XXH_P4;
+}
+
+uint64_t xxhash64(const void* buf, size_t len, uint64_t seed) {
+    const uint8_t* p = buf;
+    const uint8_t* end = p + len;
+    uint64_t h;
+
+    if (len >= 32) {
+        uint64_t v1 = seed + XXH_P1 + XXH_P2;
+        uint64_t v2 = seed + XXH_P2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - XXH_P1;
+        do {
+            v1 = xxh_round(v1, read64(p));
+            v2 = xxh_round(v2, read64(p + 8));
+            v3 = xxh_round(v3, read64(p + 16));
+            v4 = xxh_round(v4, read64(p + 24));
+            p += 32;
+        } while (end - p >= 32);
+
+        h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+        h = xxh_merge(h, v1);
+        h = xxh_merge(h, v2);
+        h = xxh_merge(h, v3);
+        h = xxh_merge(h, v4);
+    } else {
+        h = seed + XXH_P5;
+    }
+
+    h += (uint64_t)len;
+
+    while (end - p >= 8) {
+        h ^= xxh_round(0, read64(p));
+        h = rotl64(h, 27) * XXH_P1 + XXH_P4;
+        p += 8;
+    }
+    if (end - p >= 4) {
+        h ^= (uint64_t)read32(p) * XXH_P1;
+        h = rotl64(h, 23) * XXH_P2 + XXH_P3;
+        p += 4;
+    }
+    while (p < end) {
+        h ^= *p++ * XXH_P5;
+        h = rotl64(h, 11) * XXH_P1;
+    }
+
+    h ^= h >> 33;
+    h *= XXH_P2;
+    h ^= h >> 29;
+    h *= XXH_P3;
+    h ^= h >> 32;
+    return h;
+}
@@ -55,70 +55,162 @@ long atol(const char *str) {
     return sign * result;
 }
 
+// No <limits.h> here; the compiler knows the width of long.
+#define LONG_MAX __LONG_MAX__
+#define LONG_MIN (-__LONG_MAX__ - 1)
+
+static int is_space(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// Value of c as a digit in bases up to 36, or 36 if it isn't one.
+static int digit_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'Z') return c - 'A' + 10;
+    return 36;
+}
+
 long strtol(const char *str, char **endptr, int base) {
-    long result = 0;
-    int sign = 1;
+    const char *s = str;
+    int negative = 0;
 
-    // skip whitespace
-    while (*str == ' ' || *str == '\t' || *str == '\n')
-        str++;
+    if (endptr) *endptr = (char *)str;  // until digits are found
+    if (base < 0 || base == 1 || base > 36)
+        return 0;
 
-    if (*str == '-') {
-        sign = -1;
-        str++;
-    } else if (*str == '+') {
-        str++;
+    // skip whitespace
+    while (is_space(*s))
+        s++;
+
+    if (*s == '-') {
+        negative = 1;
+        s++;
+    } else if (*s == '+') {
+        s++;
     }
 
-    if (base == 0) base = 10; // minimal: default to decimal only
+    // "0x" is only a prefix when a hex digit follows; otherwise the 0
+    // is the whole number.
+    if ((base == 0 || base == 16) && s[0] == '0' && (s[1] == 'x' || s[1] == 'X') &&
+        digit_value(s[2]) < 16) {
+        s += 2;
+        base = 16;
+    } else if (base == 0) {
+        base = s[0] == '0' ? 8 : 10;
+    }
 
-    const char *start = str;
-    while (*str >= '0' && *str <= '9') {
-        int digit = *str - '0';
+    // Out-of-range values clamp to LONG_MAX/LONG_MIN; the digits are
+    // still consumed.
+    unsigned long limit = negative ? (unsigned long)LONG_MAX + 1 : (unsigned long)LONG_MAX;
+    unsigned long result = 0;
+    int overflow = 0;
+    const char *start = s;
+    for (;; s++) {
+        int digit = digit_value(*s);
         if (digit >= base) break;
-        result = result * base + digit;
-        str++;
+        if (result > (limit - digit) / base)
+            overflow = 1;
+        else
+            result = result * base + digit;
     }
 
-    if (endptr) *endptr = (char *)(str == start ? str : str);
+    if (s == start) return 0;
+    if (endptr) *endptr = (char *)s;
 
-    return sign * result;
+    if (overflow) return negative ? LONG_MIN : LONG_MAX;
+    return negative ? (long)(0 - result) : (long)result;
+}
+
+// Exact powers of ten; every one up to 1e22 is representable.
+static const double exact_pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static const double binary_pow10[] = {
+    1e1, 1e2, 1e4, 1e8, 1e16, 1e32, 1e64, 1e128, 1e256
+};
+
+// r * 10^e. Exact powers give a single rounding; beyond those the power
+// is built from squares, which costs a few ulps.
+static double scale10(double r, int e) {
+    int negative = e < 0;
+    unsigned int n = negative ? -(unsigned int)e : (unsigned int)e;
+
+    if (n <= 22)
+        return negative ? r / exact_pow10[n] : r * exact_pow10[n];
+
+    while (n > 300 && r != 0.0 && r - r == 0.0) {  // finite and nonzero
+        r = negative ? r / 1e300 : r * 1e300;
+        n -= 300;
+    }
+    double p = 1.0;
+    for (int i = 0; n; i++, n >>= 1)
+        if (n & 1) p *= binary_pow10[i];
+    return negative ? r / p : r * p;
 }
 
 double strtod(const char *str, char **endptr) {
-    double result = 0.0;
-    double frac = 0.0;
-    double div = 10.0;
-    int sign = 1;
+    const char *s = str;
+    int negative = 0;
 
     // skip whitespace
-    while (*str == ' ' || *str == '\t' || *str == '\n')
-        str++;
+    while (is_space(*s))
+        s++;
+
+    if (*s == '-') {
+        negative = 1;
+        s++;
+    } else if (*s == '+') {
+        s++;
+    }
 
-    if (*str == '-') {
-        sign = -1;
-        str++;
-    } else if (*str == '+') {
-        str++;
+    // Collect up to 19 significant digits as an integer; the decimal
+    // point and any digits beyond that only move the exponent.
+    unsigned long long mant = 0;
+    int exp10 = 0, digits = 0;
+    const unsigned long long room = (~0ull - 9) / 10;
+
+    for (; *s >= '0' && *s <= '9'; s++, digits++) {
+        if (mant <= room) mant = mant * 10 + (*s - '0');
+        else exp10++;
+    }
+    if (*s == '.') {
+        s++;
+        for (; *s >= '0' && *s <= '9'; s++, digits++) {
+            if (mant <= room) {
+                mant = mant * 10 + (*s - '0');
+                exp10--;
+            }
+        }
     }
 
-    // integer part
-    while (*str >= '0' && *str <= '9') {
-        result = result * 10.0 + (*str - '0');
-        str++;
+    if (!digits) {
+        if (endptr) *endptr = (char *)str;
+        return 0.0;
     }
 
-    // fraction part
-    if (*str == '.') {
-        str++;
-        while (*str >= '0' && *str <= '9') {
-            frac += (*str - '0') / div;
-            div *= 10.0;
-            str++;
+    // exponent, only if digits follow the e
+    if (*s == 'e' || *s == 'E') {
+        const char *e = s + 1;
+        int eneg = 0, eval = 0;
+        if (*e == '-') {
+            eneg = 1;
+            e++;
+        } else if (*e == '+') {
+            e++;
+        }
+        if (*e >= '0' && *e <= '9') {
+            for (; *e >= '0' && *e <= '9'; e++)
+                if (eval < 100000) eval = eval * 10 + (*e - '0');
+            exp10 += eneg ? -eval : eval;
+            s = e;
         }
     }
 
-    if (endptr) *endptr = (char *)str;
+    if (endptr) *endptr = (char *)s;
 
-    return sign * (result + frac);
+    double result = scale10((double)mant, exp10);
+    return negative ? -result : result;
 }
@@ -0,0 +1,235 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * stdlib/env.c
+ * 
+ * Environment variables.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <hashmap.h>
+
+// Set by crt0 from the envp the kernel hands us.
+char** environ = NULL;
+
+// Name -> position in environ, built on the first lookup. If a program
+// points environ somewhere else behind our back, the index is rebuilt.
+static hashmap env_index;
+static char** indexed_environ = NULL;
+static int indexed = 0;
+static int have_dups = 0;
+
+// environ starts out on the initial stack; the first change copies it
+// into a heap array we can grow.
+static char** owned = NULL;
+static size_t env_count = 0;
+static size_t env_capacity = 0;
+
+static pthread_mutex_t env_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static size_t name_len(const char* entry) {
+    size_t n = 0;
+    while (entry[n] && entry[n] != '=') n++;
+    return n;
+}
+
+// The index only counts as built once every entry is in it; on failure
+// it stays unbuilt and the next lookup tries again.
+static int build_index(void) {
+    if (indexed) hashmap_destroy(&env_index);
+    indexed = 0;
+    hashmap_init(&env_index, NULL);
+    have_dups = 0;
+    env_count = 0;
+
+    if (environ) {
+        while (environ[env_count]) env_count++;
+        if (environ != owned) env_capacity = 0;
+
+        if (hashmap_reserve(&env_index, env_count) != 0)
+            goto fail;
+        for (size_t i = 0; i < env_count; ++i) {
+            // Duplicate names: the first one wins, like a linear scan would.
+            size_t n = name_len(environ[i]);
+            if (hashmap_find(&env_index, environ[i], n))
+                have_dups = 1;
+            else if (hashmap_put(&env_index, environ[i], n, (void*)(uintptr_t)i) != 0)
+                goto fail;
+        }
+    }
+
+    indexed_environ = environ;
+    indexed = 1;
+    return 0;
+
+fail:
+    hashmap_destroy(&env_index);
+    return -1;
+}
+
+static int ensure_index(void) {
+    if (indexed && indexed_environ == environ) return 0;
+    return build_index();
+}
+
+static int ensure_owned(size_t extra) {
+    if (environ == owned && env_count + extra + 1 <= env_capacity)
+        return 0;
+
+    size_t cap = env_capacity ? env_capacity : 16;
+    while (cap < env_count + extra + 1) cap *= 2;
+
+    char** arr = malloc(cap * sizeof(char*));
+    if (!arr) return -1;
+    for (size_t i = 0; i < env_count; ++i)
+        arr[i] = environ[i];
+    arr[env_count] = NULL;
+
+    if (owned) free(owned);
+    owned = arr;
+    env_capacity = cap;
+    environ = arr;
+    indexed_environ = arr;
+    return 0;
+}
+
+// Put entry (already "name=value") in place of name, or append it.
+static int env_insert(char* entry, size_t n, int overwrite) {
+    struct hm_slot* s = hashmap_find(&env_index, entry, n);
+    if (s) {
+        if (!overwrite) return 0;
+        if (ensure_owned(0) != 0) return -1;
+        size_t i = (uintptr_t)s->value;
+        environ[i] = entry;
+        s->key = entry;
+        return 0;
+    }
+
+    if (ensure_owned(1) != 0) return -1;
+    if (hashmap_put(&env_index, entry, n, (void*)(uintptr_t)env_count) != 0)
+        return -1;
+    environ[env_count++] = entry;
+    environ[env_count] = NULL;
+    return 0;
+}
+
+// Drop environ[i] by moving the last entry into its place, so removal
+// stays O(1).
+static void env_drop(size_t i) {
+    env_count--;
+    if (i != env_count) {
+        char* last = environ[env_count];
+        environ[i] = last;
+        struct hm_slot* moved = hashmap_find(&env_index, last, name_len(last));
+        if (moved && (uintptr_t)moved->value == env_count)
+            moved->value = (void*)(uintptr_t)i;
+    }
+    environ[env_count] = NULL;
+}
+
+static int env_remove(const char* name, size_t n) {
+    struct hm_slot* s = hashmap_find(&env_index, name, n);
+    if (!s) return 0;
+    if (ensure_owned(0) != 0) return -1;
+
+    size_t i = (uintptr_t)s->value;
+    hashmap_remove(&env_index, name, n);
+    env_drop(i);
+
+    // The initial environment had repeated names: unset removes all of
+    // them, which needs the one linear pass.
+    if (have_dups) {
+        for (size_t j = env_count; j-- > 0; ) {
+            if (name_len(environ[j]) == n && memcmp(environ[j], name, n) == 0)
+                env_drop(j);
+        }
+    }
+    return 0;
+}
+
+static int valid_name(const char* name, size_t* len) {
+    if (!name || !*name) return 0;
+    size_t n = 0;
+    while (name[n]) {
+        if (name[n] == '=') return 0;
+        n++;
+    }
+    *len = n;
+    return 1;
+}
+
+char* getenv(const char* name) {
+    size_t n;
+    char* ret = NULL;
+
+    if (!valid_name(name, &n)) return NULL;
+
+    pthread_mutex_lock(&env_lock);
+    if (ensure_index() == 0) {
+        struct hm_slot* s = hashmap_find(&env_index, name, n);
+        if (s) ret = (char*)s->key + n + 1;
+    }
+    pthread_mutex_unlock(&env_lock);
+    return ret;
+}
+
+int setenv(const char* name, const char* value, int overwrite) {
+    size_t n;
+    if (!valid_name(name, &n)) return -1;
+    if (!value) value = "";
+
+    size_t vlen = strlen(value);
+    char* entry = malloc(n + vlen + 2);
+    if (!entry) return -1;
+    memcpy(entry, name, n);
+    entry[n] = '=';
+    memcpy(entry + n + 1, value, vlen + 1);
+
+    pthread_mutex_lock(&env_lock);
+    int ret = ensure_index();
+    if (ret == 0) {
+        int existed = hashmap_find(&env_index, entry, n) != NULL;
+        ret = env_insert(entry, n, overwrite);
+        if (ret == 0 && existed && !overwrite) {
+            free(entry);
+        }
+    }
+    pthread_mutex_unlock(&env_lock);
+
+    if (ret != 0) free(entry);
+    return ret;
+}
+
+int unsetenv(const char* name) {
+    size_t n;
+    if (!valid_name(name, &n)) return -1;
+
+    pthread_mutex_lock(&env_lock);
+    int ret = ensure_index();
+    if (ret == 0) ret = env_remove(name, n);
+    pthread_mutex_unlock(&env_lock);
+    return ret;
+}
+
+// The string itself becomes part of the environment; it is not copied.
+int putenv(char* string) {
+    size_t n = name_len(string);
+    if (n == 0) return -1;
+
+    pthread_mutex_lock(&env_lock);
+    int ret = ensure_index();
+    if (ret == 0) {
+        if (string[n] == '=')
+            ret = env_insert(string, n, 1);
+        else
+            ret = env_remove(string, n);
+    }
+    pthread_mutex_unlock(&env_lock);
+    return ret;
+}
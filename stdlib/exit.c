@@ -8,12 +8,12 @@
  *
  */
 
-void exit() {
-    asm volatile (
-            "movl $6, %%eax\n\t"
-            "int $0x80"
-            :
-            :
-            : "eax"
-        );
+#include <syscall.h>
+#include <prof.h>
+
+void exit(int status) {
+#ifdef GOLDLIBC_PROFILE
+    __prof_dump();
+#endif
+    __syscall1(SYS_EXIT, status);
 }
@@ -0,0 +1,303 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * stdlib/hashmap.c
+ * 
+ * Open-addressing hash map with Swiss-table style control bytes.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <hash.h>
+#include <hashmap.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define CTRL_EMPTY   ((int8_t)-128)  // 0b10000000
+#define CTRL_DELETED ((int8_t)-2)    // 0b11111110
+
+#define DEFAULT_SEED 0x9e3779b97f4a7c15ull
+
+// --------------------------------------------------
+// Group matching: one bit per slot in the returned mask
+// --------------------------------------------------
+#if defined(__SSE2__)
+
+#define GROUP_WIDTH 16
+typedef uint32_t group_mask;
+
+static inline group_mask match_h2(const int8_t* g, int8_t h2) {
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)g);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2)));
+}
+
+static inline group_mask match_empty(const int8_t* g) {
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)g);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(CTRL_EMPTY)));
+}
+
+static inline group_mask match_empty_or_deleted(const int8_t* g) {
+    // Both special values have the sign bit set; full slots don't.
+    return _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)g));
+}
+
+static inline int mask_first(group_mask m) {
+    return __builtin_ctz(m);
+}
+
+static inline group_mask mask_clear_first(group_mask m) {
+    return m & (m - 1);
+}
+
+#else
+
+// Portable fallback: eight control bytes in a 64-bit word, matched with
+// SWAR bit tricks. match_h2 can report false positives, which the key
+// comparison filters out anyway.
+#define GROUP_WIDTH 8
+typedef uint64_t group_mask;
+
+#define LSBS 0x0101010101010101ull
+#define MSBS 0x8080808080808080ull
+
+static inline uint64_t load_group(const int8_t* g) {
+    uint64_t v;
+    __builtin_memcpy(&v, g, 8);
+    return v;
+}
+
+static inline group_mask match_h2(const int8_t* g, int8_t h2) {
+    uint64_t x = load_group(g) ^ (LSBS * (uint8_t)h2);
+    return (x - LSBS) & ~x & MSBS;
+}
+
+static inline group_mask match_empty(const int8_t* g) {
+    uint64_t c = load_group(g);
+    return c & (~c << 6) & MSBS;
+}
+
+static inline group_mask match_empty_or_deleted(const int8_t* g) {
+    return load_group(g) & MSBS;
+}
+
+static inline int mask_first(group_mask m) {
+    return __builtin_ctzll(m) >> 3;
+}
+
+static inline group_mask mask_clear_first(group_mask m) {
+    return m & (m - 1);
+}
+
+#endif
+
+// --------------------------------------------------
+// Helpers
+// --------------------------------------------------
+static void* default_alloc(void* ctx, size_t size) {
+    (void)ctx;
+    return malloc(size);
+}
+
+static void default_free(void* ctx, void* ptr, size_t size) {
+    (void)ctx;
+    (void)size;
+    free(ptr);
+}
+
+static inline size_t h1(uint64_t h) {
+    return (size_t)(h >> 7);
+}
+
+static inline int8_t h2(uint64_t h) {
+    return (int8_t)(h & 0x7f);
+}
+
+static inline size_t max_load(size_t capacity) {
+    return capacity - capacity / 8;  // 7/8
+}
+
+static inline size_t table_bytes(size_t capacity) {
+    return capacity + capacity * sizeof(struct hm_slot);
+}
+
+// Probe groups in triangular order (+1, +2, +3, ...), which visits every
+// group exactly once when the group count is a power of two.
+#define FOR_EACH_GROUP(m, hash, g)                                          \
+    for (size_t g##_mask = (m)->capacity / GROUP_WIDTH - 1,                 \
+                g = h1(hash) & g##_mask, g##_step = 0;                      \
+         g##_step <= g##_mask;                                              \
+         ++g##_step, g = (g + g##_step) & g##_mask)
+
+static size_t find_insert_slot(const hashmap* m, uint64_t hash) {
+    FOR_EACH_GROUP(m, hash, g) {
+        group_mask avail = match_empty_or_deleted(m->ctrl + g * GROUP_WIDTH);
+        if (avail)
+            return g * GROUP_WIDTH + mask_first(avail);
+    }
+    return (size_t)-1;  // unreachable: the load factor keeps slots free
+}
+
+static int resize(hashmap* m, size_t new_capacity) {
+    int8_t* old_ctrl = m->ctrl;
+    struct hm_slot* old_slots = m->slots;
+    size_t old_capacity = m->capacity;
+
+    uint8_t* mem = m->alloc.alloc(m->alloc.ctx, table_bytes(new_capacity));
+    if (!mem) return -1;
+
+    m->ctrl = (int8_t*)mem;
+    m->slots = (struct hm_slot*)(mem + new_capacity);
+    m->capacity = new_capacity;
+    memset(m->ctrl, CTRL_EMPTY, new_capacity);
+
+    // Reinserting drops every tombstone.
+    for (size_t i = 0; i < old_capacity; ++i) {
+        if (old_ctrl[i] < 0) continue;
+        struct hm_slot* s = &old_slots[i];
+        uint64_t hash = hash_bytes(s->key, s->len, m->seed);
+        size_t pos = find_insert_slot(m, hash);
+        m->ctrl[pos] = h2(hash);
+        m->slots[pos] = *s;
+    }
+    m->growth_left = max_load(new_capacity) - m->size;
+
+    if (old_ctrl)
+        m->alloc.free(m->alloc.ctx, old_ctrl, table_bytes(old_capacity));
+    return 0;
+}
+
+static size_t capacity_for(size_t n) {
+    size_t cap = GROUP_WIDTH;
+    while (max_load(cap) < n)
+        cap <<= 1;
+    return cap;
+}
+
+// --------------------------------------------------
+// Public API
+// --------------------------------------------------
+void hashmap_init(hashmap* m, const hm_allocator* alloc) {
+    m->ctrl = NULL;
+    m->slots = NULL;
+    m->capacity = 0;
+    m->size = 0;
+    m->growth_left = 0;
+    m->seed = DEFAULT_SEED;
+    if (alloc) {
+        m->alloc = *alloc;
+    } else {
+        m->alloc.alloc = default_alloc;
+        m->alloc.free = default_free;
+        m->alloc.ctx = NULL;
+    }
+}
+
+void hashmap_destroy(hashmap* m) {
+    if (m->ctrl)
+        m->alloc.free(m->alloc.ctx, m->ctrl, table_bytes(m->capacity));
+    m->ctrl = NULL;
+    m->slots = NULL;
+    m->capacity = 0;
+    m->size = 0;
+    m->growth_left = 0;
+}
+
+void hashmap_clear(hashmap* m) {
+    if (!m->ctrl) return;
+    memset(m->ctrl, CTRL_EMPTY, m->capacity);
+    m->size = 0;
+    m->growth_left = max_load(m->capacity);
+}
+
+int hashmap_reserve(hashmap* m, size_t n) {
+    if (n <= m->size + m->growth_left) return 0;
+    return resize(m, capacity_for(n));
+}
+
+struct hm_slot* hashmap_find(const hashmap* m, const void* key, size_t len) {
+    if (m->size == 0) return NULL;
+
+    uint64_t hash = hash_bytes(key, len, m->seed);
+    int8_t tag = h2(hash);
+
+    FOR_EACH_GROUP(m, hash, g) {
+        const int8_t* ctrl = m->ctrl + g * GROUP_WIDTH;
+        for (group_mask hit = match_h2(ctrl, tag); hit; hit = mask_clear_first(hit)) {
+            struct hm_slot* s = &m->slots[g * GROUP_WIDTH + mask_first(hit)];
+            if (s->len == len && memcmp(s->key, key, len) == 0)
+                return s;
+        }
+        // An empty slot ends every probe sequence that reached this group.
+        if (match_empty(ctrl)) return NULL;
+    }
+    return NULL;
+}
+
+void* hashmap_get(const hashmap* m, const void* key, size_t len) {
+    struct hm_slot* s = hashmap_find(m, key, len);
+    return s ? s->value : NULL;
+}
+
+int hashmap_put(hashmap* m, const void* key, size_t len, void* value) {
+    struct hm_slot* s = hashmap_find(m, key, len);
+    if (s) {
+        s->key = key;
+        s->value = value;
+        return 0;
+    }
+
+    if (m->growth_left == 0) {
+        // Mostly tombstones: rebuild at the same size. Otherwise grow.
+        size_t cap = m->capacity;
+        if (cap == 0 || m->size + 1 > max_load(cap) / 2)
+            cap = capacity_for((m->size + 1) * 2);
+        if (resize(m, cap) != 0) return -1;
+    }
+
+    uint64_t hash = hash_bytes(key, len, m->seed);
+    size_t pos = find_insert_slot(m, hash);
+    if (m->ctrl[pos] == CTRL_EMPTY)
+        m->growth_left--;
+    m->ctrl[pos] = h2(hash);
+    m->slots[pos].key = key;
+    m->slots[pos].len = len;
+    m->slots[pos].value = value;
+    m->size++;
+    return 0;
+}
+
+int hashmap_remove(hashmap* m, const void* key, size_t len) {
+    struct hm_slot* s = hashmap_find(m, key, len);
+    if (!s) return -1;
+
+    size_t pos = s - m->slots;
+    const int8_t* group = m->ctrl + (pos & ~(size_t)(GROUP_WIDTH - 1));
+
+    // If the group still has an empty slot, no probe ever continued past
+    // it, so the slot can go straight back to empty without a tombstone.
+    if (match_empty(group)) {
+        m->ctrl[pos] = CTRL_EMPTY;
+        m->growth_left++;
+    } else {
+        m->ctrl[pos] = CTRL_DELETED;
+    }
+    m->size--;
+    return 0;
+}
+
+struct hm_slot* hashmap_next(const hashmap* m, size_t* iter) {
+    for (size_t i = *iter; i < m->capacity; ++i) {
+        if (m->ctrl[i] >= 0) {
+            *iter = i + 1;
+            return &m->slots[i];
+        }
+    }
+    *iter = m->capacity;
+    return NULL;
+}
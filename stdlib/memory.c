@@ -11,124 +11,324 @@
 #include <string.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <pthread.h>
+#include <lockfree.h>
+#include <prof.h>
 
-#define MEMORY_POOL_SIZE (1024 * 1024 * 128)
+// Override with -DMEMORY_POOL_SIZE=... (make HEAP_SIZE=...). On x86-64
+// the pool may exceed 4 GiB; the build uses the medium code model so a
+// pool that large can live in .lbss.
+#ifndef MEMORY_POOL_SIZE
+#define MEMORY_POOL_SIZE ((size_t)1024 * 1024 * 128)
+#endif
+
+// x86-64 ABI guarantees 16-byte alignment from malloc (SSE types,
+// long double); i386 only needs 8.
+#if defined(__x86_64__)
+#define ALIGNMENT 16
+#else
 #define ALIGNMENT 8
+#endif
 #define MAGIC_HEAD 0xDEADBEEF
 #define MAGIC_TAIL 0xBAADF00D
-#define ALIGN(size) (((size) + (ALIGNMENT - 1)) & ~(ALIGNMENT - 1))
+#define ALIGN(size) (((size) + (ALIGNMENT - 1)) & ~(size_t)(ALIGNMENT - 1))
+
+/*
+ * Block layout. A block is a header word followed by the payload; the
+ * word holds the block's total size with two flags in the low bits.
+ * Sizes are multiples of ALIGNMENT and payloads are ALIGNMENT-aligned,
+ * so the header sits just below an aligned address.
+ *
+ *   in use:  [size|flags][payload ...................]
+ *   free:    [size|flags][next][prev] ......... [size]
+ *
+ * Only free blocks carry a footer. Whether the block before this one is
+ * free is kept in PREV_USED, so coalescing can find the previous
+ * block's footer without every in-use block paying for one. PENDING
+ * marks an in-use block that free() has claimed but not yet returned
+ * (see deferred_frees); a second free() of it is then rejected.
+ *
+ * With make HEAP_DEBUG=1 every header also holds MAGIC_HEAD and every
+ * in-use block ends in MAGIC_TAIL; free() ignores pointers that fail
+ * either check.
+ */
+#define CURR_USED   ((size_t)1)
+#define PREV_USED   ((size_t)2)
+#define PENDING     ((size_t)4)
+#define FLAGS       (CURR_USED | PREV_USED | PENDING)
 
 typedef struct block_header {
-    uint32_t magic_head;
+#ifdef HEAP_DEBUG
+    size_t magic;
+#endif
     size_t size;
-    int free;
-    struct block_header* next;
 } block_header;
 
-typedef struct block_footer {
-    size_t size;
-    uint32_t magic_tail;
-} block_footer;
+// Lives in the payload of free blocks only.
+typedef struct free_links {
+    block_header* next;
+    block_header* prev;
+} free_links;
 
-static unsigned char memory_pool[MEMORY_POOL_SIZE];
-static block_header* free_list = NULL;
+#define HDR         sizeof(block_header)
+#define FOOTER      sizeof(size_t)
+#define MIN_BLOCK   ALIGN(HDR + sizeof(free_links) + FOOTER)
+
+#ifdef HEAP_DEBUG
+#define TAIL        sizeof(size_t)  // room for MAGIC_TAIL in in-use blocks
+#else
+#define TAIL        0
+#endif
+
+// Free blocks are binned by floor(log2(size)), with a bit per non-empty
+// bin.
+#define NBINS (sizeof(size_t) * 8)
+
+static unsigned char memory_pool[MEMORY_POOL_SIZE] __attribute__((aligned(ALIGNMENT)));
+static block_header* bins[NBINS];
+static size_t bin_map;
+static pthread_mutex_t heap_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Blocks freed while another thread holds heap_lock are parked here
+// instead of blocking the freeing thread; the lock holder returns them
+// to the heap before it lets go. The stack links through the payload,
+// so a block must never be pushed twice: free() sets PENDING first.
+static lf_stack deferred_frees = LF_STACK_INIT;
+
+static inline size_t block_size(const block_header* b) {
+    return b->size & ~FLAGS;
+}
+
+static inline block_header* next_block(block_header* b) {
+    return (block_header*)((uint8_t*)b + block_size(b));
+}
 
-void write_footer(block_header* block) {
-    block_footer* footer = (block_footer*)((uint8_t*)block + sizeof(block_header) + block->size);
-    footer->size = block->size;
-    footer->magic_tail = MAGIC_TAIL;
+static inline free_links* links(block_header* b) {
+    return (free_links*)((uint8_t*)b + HDR);
 }
 
-block_footer* get_footer(block_header* block) {
-    return (block_footer*)((uint8_t*)block + sizeof(block_header) + block->size);
+static inline void* payload(block_header* b) {
+    return (uint8_t*)b + HDR;
 }
 
-block_header* get_next_block(block_header* block) {
-    return (block_header*)((uint8_t*)block + sizeof(block_header) + block->size + sizeof(block_footer));
+static inline block_header* from_payload(void* ptr) {
+    return (block_header*)((uint8_t*)ptr - HDR);
 }
 
-block_header* get_prev_block(block_header* block) {
-    block_footer* prev_footer = (block_footer*)((uint8_t*)block - sizeof(block_footer));
-    if (prev_footer->magic_tail != MAGIC_TAIL) return NULL;
-    block_header* prev_block = (block_header*)((uint8_t*)block - prev_footer->size - sizeof(block_header) - sizeof(block_footer));
-    if (prev_block->magic_head != MAGIC_HEAD) return NULL;
-    return prev_block;
+static inline void set_header(block_header* b, size_t size_flags) {
+#ifdef HEAP_DEBUG
+    b->magic = MAGIC_HEAD;
+#endif
+    b->size = size_flags;
+}
+
+static inline void write_footer(block_header* b) {
+    size_t size = block_size(b);
+    *(size_t*)((uint8_t*)b + size - FOOTER) = size;
+}
+
+static inline int bin_index(size_t size) {
+    return (int)(NBINS - 1) - __builtin_clzl((unsigned long)size);
+}
+
+static void bin_insert(block_header* b) {
+    int i = bin_index(block_size(b));
+    free_links* l = links(b);
+    l->prev = NULL;
+    l->next = bins[i];
+    if (bins[i]) links(bins[i])->prev = b;
+    bins[i] = b;
+    bin_map |= (size_t)1 << i;
+}
+
+static void bin_remove(block_header* b) {
+    int i = bin_index(block_size(b));
+    free_links* l = links(b);
+    if (l->prev) links(l->prev)->next = l->next;
+    else bins[i] = l->next;
+    if (l->next) links(l->next)->prev = l->prev;
+    if (!bins[i]) bin_map &= ~((size_t)1 << i);
 }
 
 void init_heap() {
-    free_list = (block_header*)memory_pool;
-    free_list->magic_head = MAGIC_HEAD;
-    free_list->size = MEMORY_POOL_SIZE - sizeof(block_header) - sizeof(block_footer);
-    free_list->free = 1;
-    free_list->next = NULL;
-    write_footer(free_list);
+    // The first payload lands on the pool's first aligned boundary past
+    // a header. A zero-sized in-use header at the end stops coalescing.
+    block_header* first = (block_header*)(memory_pool + ALIGNMENT - HDR);
+    size_t size = (MEMORY_POOL_SIZE - ALIGNMENT) & ~(size_t)(ALIGNMENT - 1);
+
+    set_header(first, size | PREV_USED);
+    write_footer(first);
+    bin_insert(first);
+    set_header(next_block(first), CURR_USED);
 }
 
-void* malloc(size_t size) {
-    size = ALIGN(size);
-    block_header* current = free_list;
-
-    while (current) {
-        if (current->free && current->size >= size) {
-            size_t remaining = current->size - size;
-
-            if (remaining >= sizeof(block_header) + sizeof(block_footer) + ALIGNMENT) {
-                // Split the block
-                block_header* new_block = (block_header*)((uint8_t*)current + sizeof(block_header) + size + sizeof(block_footer));
-                new_block->magic_head = MAGIC_HEAD;
-                new_block->size = remaining - sizeof(block_header) - sizeof(block_footer);
-                new_block->free = 1;
-                new_block->next = current->next;
-                write_footer(new_block);
-
-                current->size = size;
-                current->next = new_block;
-                write_footer(current);
-            }
-
-            current->free = 0;
-            return (void*)((uint8_t*)current + sizeof(block_header));
+static void release_block(block_header* block);
+
+static void drain_deferred(void) {
+    struct lf_node* n = lf_stack_pop_all(&deferred_frees);
+    while (n) {
+        struct lf_node* next = n->next;
+        release_block(from_payload(n));
+        n = next;
+    }
+}
+
+// Drop heap_lock without stranding blocks parked while it was held. A
+// free that lands after the last drain but before the unlock sees the
+// lock still taken, so check again once it is released. A push that
+// lands after that check is picked up by the freeing thread itself (see
+// heap_free).
+static void heap_unlock(void) {
+    do {
+        drain_deferred();
+        pthread_mutex_unlock(&heap_lock);
+    } while (!lf_stack_empty(&deferred_frees) &&
+             pthread_mutex_trylock(&heap_lock) == 0);
+}
+
+// Find a free block of at least size bytes and take it out of its bin:
+// first fit within the request's own bin, otherwise the head of the next
+// non-empty bin, where every block is big enough.
+static block_header* take_free(size_t size) {
+    int i = bin_index(size);
+    for (block_header* b = bins[i]; b; b = links(b)->next) {
+        if (block_size(b) >= size) {
+            bin_remove(b);
+            return b;
         }
+    }
+
+    if (i + 1 >= (int)NBINS) return NULL;
+    size_t higher = bin_map & ~(((size_t)2 << i) - 1);
+    if (!higher) return NULL;
+    block_header* b = bins[__builtin_ctzl((unsigned long)higher)];
+    bin_remove(b);
+    return b;
+}
 
-        current = current->next;
+static void* heap_alloc(size_t size) {
+    if (size > MEMORY_POOL_SIZE) return NULL;
+    size_t need = ALIGN(size + HDR + TAIL);
+    if (need < MIN_BLOCK) need = MIN_BLOCK;
+
+    pthread_mutex_lock(&heap_lock);
+    drain_deferred();
+
+    block_header* b = take_free(need);
+    if (!b) {
+        heap_unlock();
+        return NULL; // Out of memory
     }
 
-    return NULL; // Out of memory
+    size_t have = block_size(b);
+    size_t prev_used = b->size & PREV_USED;
+    if (have - need >= MIN_BLOCK) {
+        // Split; the remainder stays free, so its successor's PREV_USED
+        // is already clear.
+        block_header* rest = (block_header*)((uint8_t*)b + need);
+        set_header(rest, (have - need) | PREV_USED);
+        write_footer(rest);
+        bin_insert(rest);
+        have = need;
+    } else {
+        // Atomic: the successor may be in use and getting PENDING set by
+        // a free() that doesn't hold the lock.
+        __atomic_fetch_or(&next_block(b)->size, PREV_USED, __ATOMIC_RELAXED);
+    }
+    set_header(b, have | prev_used | CURR_USED);
+#ifdef HEAP_DEBUG
+    *(size_t*)((uint8_t*)b + have - TAIL) = MAGIC_TAIL;
+#endif
+
+    heap_unlock();
+    return payload(b);
 }
 
-void free(void* ptr) {
-    if (!ptr) return;
+// Check the block and claim it for freeing by setting PENDING. The CAS
+// only succeeds on a header that is in use and not already claimed, so
+// of two frees of the same pointer exactly one gets through, and a
+// block that is already free is never written to.
+static int claim_block(block_header* b) {
+#ifdef HEAP_DEBUG
+    if (b->magic != MAGIC_HEAD) return 0;
+#endif
+    size_t size = __atomic_load_n(&b->size, __ATOMIC_RELAXED);
+    do {
+        if ((size & (CURR_USED | PENDING)) != CURR_USED) return 0; // double free
+    } while (!__atomic_compare_exchange_n(&b->size, &size, size | PENDING, 1,
+                                          __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+#ifdef HEAP_DEBUG
+    if (*(size_t*)((uint8_t*)b + block_size(b) - TAIL) != MAGIC_TAIL) {
+        __atomic_fetch_and(&b->size, ~PENDING, __ATOMIC_RELAXED);
+        return 0;
+    }
+#endif
+    return 1;
+}
 
-    block_header* block = (block_header*)((uint8_t*)ptr - sizeof(block_header));
+static void heap_free(void* ptr) {
+    block_header* block = from_payload(ptr);
 
     // Check for corruption
-    if (block->magic_head != MAGIC_HEAD || get_footer(block)->magic_tail != MAGIC_TAIL) {
-        // Corrupted block
+    if (!claim_block(block)) {
+        return;
+    }
+
+    // Don't wait on the lock: park the block for the current holder.
+    // The holder may have made its last check before the push, so try
+    // once more; if the lock is still taken, whoever holds it drains
+    // the stack before letting go.
+    if (pthread_mutex_trylock(&heap_lock) != 0) {
+        lf_stack_push(&deferred_frees, (struct lf_node*)ptr);
+        if (pthread_mutex_trylock(&heap_lock) == 0)
+            heap_unlock();
         return;
     }
 
-    block->free = 1;
+    release_block(block);
+    heap_unlock();
+}
+
+void* malloc(size_t size) {
+    PROF_START(t0);
+    void* p = heap_alloc(size);
+    PROF_STOP(PROF_MALLOC, t0, size);
+    return p;
+}
+
+void free(void* ptr) {
+    if (!ptr) return;
+    PROF_START(t0);
+    heap_free(ptr);
+    PROF_STOP(PROF_FREE, t0, 0);
+}
+
+// Mark a block free and coalesce it with its neighbours. Caller holds
+// heap_lock.
+static void release_block(block_header* block) {
+    size_t size = block_size(block);
+    size_t prev_used = block->size & PREV_USED;
 
     // Coalesce with next block if possible
-    block_header* next = get_next_block(block);
-    if ((uint8_t*)next < memory_pool + MEMORY_POOL_SIZE &&
-        next->magic_head == MAGIC_HEAD && next->free &&
-        get_footer(next)->magic_tail == MAGIC_TAIL) {
-
-        block->size += sizeof(block_header) + next->size + sizeof(block_footer);
-        block->next = next->next;
-        write_footer(block);
+    block_header* next = next_block(block);
+    if (!(next->size & CURR_USED)) {
+        bin_remove(next);
+        size += block_size(next);
     }
 
     // Coalesce with previous block if possible
-    block_header* prev = get_prev_block(block);
-    if (prev && prev->free) {
-        prev->size += sizeof(block_header) + block->size + sizeof(block_footer);
-        prev->next = block->next;
-        write_footer(prev);
-    } else {
-        write_footer(block);
+    if (!prev_used) {
+        size_t prev_size = *(size_t*)((uint8_t*)block - FOOTER);
+        block = (block_header*)((uint8_t*)block - prev_size);
+        bin_remove(block);
+        size += prev_size;
     }
+
+    // Whatever precedes a free block is in use, or they'd have merged.
+    set_header(block, size | PREV_USED);
+    write_footer(block);
+    bin_insert(block);
+    __atomic_fetch_and(&next_block(block)->size, ~PREV_USED, __ATOMIC_RELAXED);
 }
 
 void *realloc(void *ptr, size_t new_size) {
@@ -136,21 +336,27 @@ void *realloc(void *ptr, size_t new_size) {
         // If ptr is NULL, just allocate new memory
         return malloc(new_size);
     }
-    
+
     if (new_size == 0) {
         // If new_size is 0, free the memory and return NULL
         free(ptr);
         return NULL;
     }
 
+    // Still fits: keep the block
+    size_t usable = block_size(from_payload(ptr)) - HDR - TAIL;
+    if (new_size <= usable) {
+        return ptr;
+    }
+
     // Allocate new memory block
     void *new_ptr = malloc(new_size);
     if (!new_ptr) {
         return NULL;  // Failed to allocate
     }
 
-    // Copy old data to new block (only up to the new size)
-    memcpy(new_ptr, ptr, new_size);  
+    // Copy old data to new block (all of it; the new block is larger)
+    memcpy(new_ptr, ptr, usable);
 
     // Free old block
     free(ptr);
@@ -159,7 +365,8 @@ void *realloc(void *ptr, size_t new_size) {
 }
 
 void *calloc(size_t nmemb, size_t size) {
-    size_t total = nmemb * size;
+    size_t total;
+    if (__builtin_mul_overflow(nmemb, size, &total)) return NULL;
     void *ptr = malloc(total);
     if (!ptr) return NULL;        // malloc failed, bail out
     memset(ptr, 0, total);        // zero out the memory
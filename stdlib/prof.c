@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * stdlib/prof.c
+ * 
+ * Hot-path counters for profiled builds (make PROFILE=1).
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#ifdef GOLDLIBC_PROFILE
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <syscall.h>
+#include <prof.h>
+
+struct prof_counter {
+    volatile uint64_t calls;
+    volatile uint64_t bytes;
+    volatile uint64_t cycles;
+};
+
+static struct prof_counter counters[PROF_NSITES];
+
+static const char* const site_names[PROF_SYSCALL] = {
+    "malloc", "free", "memcpy", "memset", "printf"
+};
+
+// Every number below SYS_MAX needs a name here; this trips when one is
+// added to syscall.h without one.
+_Static_assert(SYS_MAX == SYS_NPROCS + 1, "name the new syscall in syscall_names");
+
+static const char* const syscall_names[PROF_NSYSCALLS] = {
+    [SYS_OPEN] = "sys_open",           [SYS_WRITE] = "sys_write",
+    [SYS_READ] = "sys_read",           [SYS_CLOSE] = "sys_close",
+    [SYS_SPAWN] = "sys_spawn",         [SYS_EXIT] = "sys_exit",
+    [SYS_STAT] = "sys_stat",           [SYS_PRINT] = "sys_print",
+    [SYS_THREAD_CREATE] = "sys_thread_create",
+    [SYS_THREAD_EXIT] = "sys_thread_exit",
+    [SYS_FUTEX_WAIT] = "sys_futex_wait",
+    [SYS_FUTEX_WAKE] = "sys_futex_wake",
+    [SYS_SET_TLS] = "sys_set_tls",     [SYS_YIELD] = "sys_yield",
+    [SYS_CLOCK_GETTIME] = "sys_clock_gettime",
+    [SYS_WAITPID] = "sys_waitpid",     [SYS_PIPE] = "sys_pipe",
+    [SYS_DUP2] = "sys_dup2",           [SYS_FCNTL] = "sys_fcntl",
+    [SYS_GETDENTS] = "sys_getdents",   [SYS_NPROCS] = "sys_nprocs",
+    [SYS_MAX] = "sys_other",
+};
+
+void __prof_record(int site, uint64_t bytes, uint64_t cycles) {
+    struct prof_counter* c = &counters[site];
+    atomic_fetch_add_u64(&c->calls, 1);
+    atomic_fetch_add_u64(&c->bytes, bytes);
+    atomic_fetch_add_u64(&c->cycles, cycles);
+}
+
+void __prof_syscall(long n, long ret, uint64_t start) {
+    uint64_t cycles = __builtin_ia32_rdtsc() - start;
+    uint64_t bytes = 0;
+    if ((n == SYS_READ || n == SYS_WRITE) && ret > 0)
+        bytes = (uint64_t)ret;
+    if (n < 0 || n >= PROF_NSYSCALLS)
+        n = PROF_NSYSCALLS - 1;
+    __prof_record(PROF_SYSCALL + (int)n, bytes, cycles);
+}
+
+// --------------------------------------------------
+// Table output. Built by hand: the format engine has no 64-bit
+// conversions, and going through printf would count the dump itself.
+// --------------------------------------------------
+static char* put_str(char* p, const char* s, size_t width) {
+    size_t n = 0;
+    while (s[n]) *p++ = s[n++];
+    while (n++ < width) *p++ = ' ';
+    return p;
+}
+
+static char* put_u64(char* p, uint64_t v, size_t width) {
+    char tmp[24];
+    size_t n = 0;
+    do {
+        tmp[n++] = '0' + (char)(v % 10);
+        v /= 10;
+    } while (v);
+    while (width-- > n) *p++ = ' ';
+    while (n) *p++ = tmp[--n];
+    return p;
+}
+
+void __prof_dump(void) {
+    char line[128];
+    char* p;
+
+    p = put_str(line, "site", 20);
+    p = put_str(p, "           calls           bytes          cycles  cycles/call\n", 0);
+    *p = '\0';
+    (__syscall1)(SYS_PRINT, (long)line);
+
+    for (int i = 0; i < PROF_NSITES; i++) {
+        uint64_t calls = atomic_load_u64(&counters[i].calls);
+        if (!calls) continue;
+        uint64_t bytes = atomic_load_u64(&counters[i].bytes);
+        uint64_t cycles = atomic_load_u64(&counters[i].cycles);
+
+        const char* name = i < PROF_SYSCALL ? site_names[i] : syscall_names[i - PROF_SYSCALL];
+        p = put_str(line, name ? name : "sys_other", 20);
+        p = put_u64(p, calls, 16);
+        p = put_u64(p, bytes, 16);
+        p = put_u64(p, cycles, 16);
+        p = put_u64(p, cycles / calls, 13);
+        *p++ = '\n';
+        *p = '\0';
+        (__syscall1)(SYS_PRINT, (long)line);
+    }
+}
+
+#endif
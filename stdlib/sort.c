@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * stdlib/sort.c
+ * 
+ * Sorting and searching.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sort_impl.h>
+
+#define INSERTION_CUTOFF 16
+
+// --------------------------------------------------
+// Introsort
+// --------------------------------------------------
+static void insertion_sort(char* a, size_t n, size_t size, cmp_fn cmp, swap_fn swap) {
+    for (size_t i = 1; i < n; ++i)
+        for (char* p = a + i * size; p > a && cmp(p - size, p) > 0; p -= size)
+            swap(p - size, p, size);
+}
+
+static void sift_down(char* a, size_t root, size_t n, size_t size, cmp_fn cmp, swap_fn swap) {
+    for (;;) {
+        size_t child = 2 * root + 1;
+        if (child >= n) return;
+        if (child + 1 < n && cmp(a + child * size, a + (child + 1) * size) < 0)
+            ++child;
+        if (cmp(a + root * size, a + child * size) >= 0) return;
+        swap(a + root * size, a + child * size, size);
+        root = child;
+    }
+}
+
+static void heap_sort(char* a, size_t n, size_t size, cmp_fn cmp, swap_fn swap) {
+    for (size_t i = n / 2; i-- > 0; )
+        sift_down(a, i, n, size, cmp, swap);
+    for (size_t end = n - 1; end > 0; --end) {
+        swap(a, a + end * size, size);
+        sift_down(a, 0, end, size, cmp, swap);
+    }
+}
+
+static void introsort(char* a, size_t n, size_t size, cmp_fn cmp, swap_fn swap, int depth) {
+    while (n > INSERTION_CUTOFF) {
+        // Partitioning has gone bad too many times: fall back to heapsort
+        // so adversarial inputs stay O(n log n).
+        if (depth-- == 0) {
+            heap_sort(a, n, size, cmp, swap);
+            return;
+        }
+
+        size_t p = partition(a, n, size, cmp, swap);
+        if (p < n - p - 1) {
+            introsort(a, p, size, cmp, swap, depth);
+            a += (p + 1) * size;
+            n -= p + 1;
+        } else {
+            introsort(a + (p + 1) * size, n - p - 1, size, cmp, swap, depth);
+            n = p;
+        }
+    }
+    insertion_sort(a, n, size, cmp, swap);
+}
+
+void qsort(void* base, size_t nmemb, size_t size, int (*compar)(const void*, const void*)) {
+    if (nmemb < 2 || size == 0) return;
+
+    int depth = 0;
+    for (size_t n = nmemb; n > 1; n >>= 1)
+        depth += 2;
+
+    introsort(base, nmemb, size, compar, pick_swap(size), depth);
+}
+
+void* bsearch(const void* key, const void* base, size_t nmemb, size_t size,
+              int (*compar)(const void*, const void*)) {
+    const char* lo = base;
+
+    while (nmemb > 0) {
+        const char* mid = lo + (nmemb / 2) * size;
+        int c = compar(key, mid);
+        if (c == 0) return (void*)mid;
+        if (c > 0) {
+            lo = mid + size;
+            nmemb -= nmemb / 2 + 1;
+        } else {
+            nmemb /= 2;
+        }
+    }
+    return NULL;
+}
+
+// --------------------------------------------------
+// LSD radix sort for integer keys
+// --------------------------------------------------
+// One counting pass builds all the byte histograms up front, then each
+// byte gets a scatter pass. Bytes where every key lands in the same
+// bucket (common for small values or shared prefixes) are skipped.
+#define RADIX_SORT(name, type)                                              \
+int name(type* keys, size_t n) {                                            \
+    size_t counts[sizeof(type)][256] = { { 0 } };                           \
+                                                                            \
+    if (n < 2) return 0;                                                    \
+                                                                            \
+    type* tmp = malloc(n * sizeof(type));                                   \
+    if (!tmp) return -1;                                                    \
+                                                                            \
+    for (size_t i = 0; i < n; ++i)                                          \
+        for (size_t b = 0; b < sizeof(type); ++b)                           \
+            counts[b][(keys[i] >> (b * 8)) & 0xff]++;                       \
+                                                                            \
+    type* src = keys;                                                       \
+    type* dst = tmp;                                                        \
+    for (size_t b = 0; b < sizeof(type); ++b) {                             \
+        size_t* c = counts[b];                                              \
+        if (c[(src[0] >> (b * 8)) & 0xff] == n) continue;                   \
+                                                                            \
+        size_t sum = 0;                                                     \
+        for (int d = 0; d < 256; ++d) {                                     \
+            size_t t = c[d];                                                \
+            c[d] = sum;                                                     \
+            sum += t;                                                       \
+        }                                                                   \
+        for (size_t i = 0; i < n; ++i)                                      \
+            dst[c[(src[i] >> (b * 8)) & 0xff]++] = src[i];                  \
+                                                                            \
+        type* t = src;                                                      \
+        src = dst;                                                          \
+        dst = t;                                                            \
+    }                                                                       \
+                                                                            \
+    if (src != keys)                                                        \
+        for (size_t i = 0; i < n; ++i)                                      \
+            keys[i] = src[i];                                               \
+    free(tmp);                                                              \
+    return 0;                                                               \
+}
+
+RADIX_SORT(radix_sort_u32, uint32_t)
+RADIX_SORT(radix_sort_u64, uint64_t)
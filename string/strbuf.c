@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * string/strbuf.c
+ * 
+ * Growable string builder.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <format.h>
+#include <strbuf.h>
+
+static inline int on_heap(const strbuf* sb) {
+    return sb->data != sb->inline_buf;
+}
+
+void sb_init(strbuf* sb) {
+    sb->data = sb->inline_buf;
+    sb->len = 0;
+    sb->cap = SB_INLINE_SIZE - 1;
+    sb->inline_buf[0] = '\0';
+}
+
+void sb_free(strbuf* sb) {
+    if (on_heap(sb)) free(sb->data);
+    sb_init(sb);
+}
+
+void sb_reset(strbuf* sb) {
+    sb->len = 0;
+    sb->data[0] = '\0';
+}
+
+int sb_reserve(strbuf* sb, size_t extra) {
+    size_t need = sb->len + extra;
+    if (need <= sb->cap) return 0;
+
+    size_t cap = sb->cap * 2;
+    if (cap < need) cap = need;
+
+    char* p;
+    if (on_heap(sb)) {
+        p = realloc(sb->data, cap + 1);
+        if (!p) return -1;
+    } else {
+        p = malloc(cap + 1);
+        if (!p) return -1;
+        memcpy(p, sb->data, sb->len + 1);
+    }
+    sb->data = p;
+    sb->cap = cap;
+    return 0;
+}
+
+int sb_appendn(strbuf* sb, const char* s, size_t n) {
+    if (sb_reserve(sb, n) != 0) return -1;
+    memcpy(sb->data + sb->len, s, n);
+    sb->len += n;
+    sb->data[sb->len] = '\0';
+    return 0;
+}
+
+int sb_append(strbuf* sb, const char* s) {
+    return sb_appendn(sb, s, strlen(s));
+}
+
+int sb_appendc(strbuf* sb, char c) {
+    if (sb->len == sb->cap && sb_reserve(sb, 1) != 0) return -1;
+    sb->data[sb->len++] = c;
+    sb->data[sb->len] = '\0';
+    return 0;
+}
+
+// The formatter writes straight into the builder's storage; nothing is
+// formatted into a temporary first.
+struct sb_sink {
+    strbuf* sb;
+    int failed;
+};
+
+static void sb_put(void* ctx, const char* s, size_t n) {
+    struct sb_sink* k = ctx;
+    if (k->failed) return;
+    if (sb_reserve(k->sb, n) != 0) {
+        k->failed = 1;
+        return;
+    }
+    memcpy(k->sb->data + k->sb->len, s, n);
+    k->sb->len += n;
+}
+
+int sb_vappendf(strbuf* sb, const char* fmt, va_list args) {
+    struct sb_sink k = { sb, 0 };
+    size_t start = sb->len;
+    int n = __vformat(sb_put, &k, fmt, args);
+    sb->data[sb->len] = '\0';
+    if (k.failed) {
+        sb->len = start;
+        sb->data[start] = '\0';
+        return -1;
+    }
+    return n;
+}
+
+int sb_appendf(strbuf* sb, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    int ret = sb_vappendf(sb, fmt, args);
+    va_end(args);
+    return ret;
+}
+
+char* sb_detach(strbuf* sb, size_t* len) {
+    char* ret;
+    if (on_heap(sb)) {
+        ret = sb->data;
+    } else {
+        ret = malloc(sb->len + 1);
+        if (!ret) return NULL;
+        memcpy(ret, sb->data, sb->len + 1);
+    }
+    if (len) *len = sb->len;
+    sb_init(sb);
+    return ret;
+}
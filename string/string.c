@@ -10,9 +10,14 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
 short strcspn(const char *s1, const char *s2);
 
+// Word reads over char data; may_alias keeps them valid under LTO.
+typedef unsigned long __attribute__((may_alias)) word_alias;
+
 char *strpbrk(const char *str1, const char *str2) {
     const char *sc1;
     const char *sc2;
@@ -26,12 +31,26 @@ char *strpbrk(const char *str1, const char *str2) {
     return NULL;  /* terminating nulls match */
 }
 
-size_t strlen(const char *str) {
-    size_t len = 0;
-    while (*str++) {
-        len++;
+size_t (strlen)(const char *str) {
+    const char *p = str;
+
+    // Byte steps up to word alignment, so the word reads below never
+    // cross into a page the string doesn't touch.
+    while ((uintptr_t)p & (sizeof(unsigned long) - 1)) {
+        if (!*p) return p - str;
+        p++;
     }
-    return len;
+
+    // A word has a zero byte iff (w - 0x01..01) & ~w & 0x80..80 != 0.
+    const unsigned long ones = (unsigned long)-1 / 0xff;
+    const unsigned long highs = ones << 7;
+    const word_alias *w = (const word_alias *)p;
+    while (!((*w - ones) & ~*w & highs))
+        w++;
+
+    p = (const char *)w;
+    while (*p) p++;
+    return p - str;
 }
 
 int strcmp(const char *s1, const char *s2) {
@@ -42,23 +61,22 @@ int strcmp(const char *s1, const char *s2) {
     return *(unsigned char *)s1 - *(unsigned char *)s2;
 }
 
-char strcat(char *dest, const char *src)
+char *strcat(char *dest, const char *src)
 {
-    char *ret = dest;
-    while (*dest)
-        dest++;
-    while (*dest++ = *src++);
-    return ret;
+    stpcpy(dest + strlen(dest), src);
+    return dest;
 }
 
 char *strchr(const char *str, int c) {
-    while (*str) {
+    // The terminator counts as part of the string: strchr(s, 0) finds it.
+    for (;; str++) {
         if (*str == (char)c) {
             return (char *)str;
         }
-        str++;
+        if (!*str) {
+            return NULL;
+        }
     }
-    return NULL;
 }
 
 char *strcpy(char *dest, const char* src)
@@ -71,52 +89,56 @@ char *strcpy(char *dest, const char* src)
 short strspn(const char *s1, const char *s2)
 {
     short ret=0;
-    while(*s1 && my_strchr(s2,*s1++))
+    while(*s1 && strchr(s2,*s1++))
         ret++;
     return ret;
 }
 
-char *strtok(char* str, const char* delim) {
-    static char* last;
+char *strtok_r(char* str, const char* delim, char** saveptr) {
     if (str == NULL) {
-        str = last;
+        str = *saveptr;
     }
     if (str == NULL) {
         return NULL;
     }
 
     // Skip leading delimiters
-    while (*str && my_strchr(delim, *str)) {
+    while (*str && strchr(delim, *str)) {
         str++;
     }
 
     if (*str == '\0') {
-        last = NULL;
+        *saveptr = NULL;
         return NULL;
     }
 
     char* token_start = str;
 
     // Find the end of the token
-    while (*str && !my_strchr(delim, *str)) {
+    while (*str && !strchr(delim, *str)) {
         str++;
     }
 
     if (*str == '\0') {
-        last = NULL;
+        *saveptr = NULL;
     } else {
         *str = '\0';
-        last = str + 1;
+        *saveptr = str + 1;
     }
 
     return token_start;
 }
 
+char *strtok(char* str, const char* delim) {
+    static char* last;
+    return strtok_r(str, delim, &last);
+}
+
 short strcspn(const char *s1, const char *s2)
 {
     short ret=0;
     while(*s1)
-        if(my_strchr(s2,*s1) != NULL)
+        if(strchr(s2,*s1) != NULL)
             return ret;
         else
             s1++,ret++;
@@ -137,3 +159,53 @@ char* strncpy(char* dest, const char* src, size_t n) {
 
     return dest;
 }
+
+// stpcpy: like strcpy, but returns a pointer to the terminating NUL in
+// dest, so a run of appends never rescans what's already there.
+char *stpcpy(char *dest, const char *src)
+{
+    while ((*dest = *src++))
+        dest++;
+    return dest;
+}
+
+// strlcpy: copy at most size - 1 bytes and always terminate. Returns
+// strlen(src), so truncation is detectable as a return value >= size.
+size_t strlcpy(char *dest, const char *src, size_t size)
+{
+    size_t len = strlen(src);
+    if (size) {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dest, src, n);
+        dest[n] = '\0';
+    }
+    return len;
+}
+
+size_t strnlen(const char *str, size_t maxlen)
+{
+    size_t len = 0;
+    while (len < maxlen && str[len])
+        len++;
+    return len;
+}
+
+char *strdup(const char *str)
+{
+    size_t len = strlen(str) + 1;
+    char *ret = malloc(len);
+    if (ret)
+        memcpy(ret, str, len);
+    return ret;
+}
+
+char *strndup(const char *str, size_t n)
+{
+    size_t len = strnlen(str, n);
+    char *ret = malloc(len + 1);
+    if (ret) {
+        memcpy(ret, str, len);
+        ret[len] = '\0';
+    }
+    return ret;
+}
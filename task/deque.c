@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * task/deque.c
+ * 
+ * Chase-Lev work-stealing deque.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <task.h>
+
+#define MASK (TASK_DEQUE_SIZE - 1)
+
+void task_deque_init(task_deque* d) {
+    atomic_store_explicit(&d->top, 0, memory_order_relaxed);
+    atomic_store_explicit(&d->bottom, 0, memory_order_relaxed);
+}
+
+int task_deque_push(task_deque* d, task_t* t) {
+    long b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+    long top = atomic_load_explicit(&d->top, memory_order_acquire);
+
+    if (b - top >= TASK_DEQUE_SIZE)
+        return -1;
+
+    atomic_store_explicit(&d->slots[b & MASK], (uintptr_t)t, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    return 0;
+}
+
+task_t* task_deque_pop(task_deque* d) {
+    long b = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&d->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long top = atomic_load_explicit(&d->top, memory_order_relaxed);
+
+    if (top > b) {
+        // Empty
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return NULL;
+    }
+
+    task_t* t = (task_t*)atomic_load_explicit(&d->slots[b & MASK], memory_order_relaxed);
+    if (top == b) {
+        // Last element: race thieves for it.
+        if (!atomic_compare_exchange_strong_explicit(&d->top, &top, top + 1,
+                                                     memory_order_seq_cst, memory_order_relaxed))
+            t = NULL;
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    }
+    return t;
+}
+
+task_t* task_deque_steal(task_deque* d) {
+    long top = atomic_load_explicit(&d->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long b = atomic_load_explicit(&d->bottom, memory_order_acquire);
+
+    if (top >= b)
+        return NULL;
+
+    task_t* t = (task_t*)atomic_load_explicit(&d->slots[top & MASK], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&d->top, &top, top + 1,
+                                                 memory_order_seq_cst, memory_order_relaxed))
+        return NULL;  // Lost the race; caller moves on to another victim
+    return t;
+}
@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * task/parallel.c
+ * 
+ * parallel_for and parallel_qsort on top of the work-stealing pool.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <task.h>
+#include <sort_impl.h>
+
+#define MAX_SPLITS 32
+#define PAR_SORT_CUTOFF 8192
+
+static void ensure_pool(void) {
+    if (task_pool_size() == 0)
+        task_pool_init(0);
+}
+
+// --------------------------------------------------
+// parallel_for
+// --------------------------------------------------
+struct range_task {
+    task_t task;
+    size_t begin, end, grain;
+    void (*fn)(size_t, size_t, void*);
+    void* ctx;
+};
+
+static void run_range(size_t begin, size_t end, size_t grain,
+                      void (*fn)(size_t, size_t, void*), void* ctx);
+
+static void range_task_fn(task_t* t) {
+    struct range_task* r = (struct range_task*)t;
+    run_range(r->begin, r->end, r->grain, r->fn, r->ctx);
+}
+
+// Peel off the upper half repeatedly as stealable tasks and run the
+// remaining low chunk here. Thieves get big pieces first, which keeps
+// the number of steals around log(n / grain) per worker.
+static void run_range(size_t begin, size_t end, size_t grain,
+                      void (*fn)(size_t, size_t, void*), void* ctx) {
+    struct range_task sub[MAX_SPLITS];
+    atomic_int pending = 0;
+    int n = 0;
+
+    while (end - begin > grain && n < MAX_SPLITS) {
+        size_t mid = begin + (end - begin) / 2;
+        sub[n].task.fn = range_task_fn;
+        sub[n].begin = mid;
+        sub[n].end = end;
+        sub[n].grain = grain;
+        sub[n].fn = fn;
+        sub[n].ctx = ctx;
+        task_spawn(&sub[n].task, &pending);
+        ++n;
+        end = mid;
+    }
+
+    fn(begin, end, ctx);
+    task_wait(&pending);
+}
+
+void parallel_for(size_t begin, size_t end, size_t grain,
+                  void (*fn)(size_t begin, size_t end, void* ctx), void* ctx) {
+    if (begin >= end) return;
+    if (grain == 0) grain = 1;
+    ensure_pool();
+    run_range(begin, end, grain, fn, ctx);
+}
+
+// --------------------------------------------------
+// parallel_qsort
+// --------------------------------------------------
+struct sort_task {
+    task_t task;
+    char* base;
+    size_t n, size;
+    cmp_fn cmp;
+    swap_fn swap;
+};
+
+static void run_sort(char* a, size_t n, size_t size, cmp_fn cmp, swap_fn swap);
+
+static void sort_task_fn(task_t* t) {
+    struct sort_task* s = (struct sort_task*)t;
+    run_sort(s->base, s->n, s->size, s->cmp, s->swap);
+}
+
+// Partitioning uses qsort's size-specialized swaps, and the leaves are
+// plain qsort calls.
+static void run_sort(char* a, size_t n, size_t size, cmp_fn cmp, swap_fn swap) {
+    struct sort_task sub[MAX_SPLITS];
+    atomic_int pending = 0;
+    int k = 0;
+
+    while (n > PAR_SORT_CUTOFF && k < MAX_SPLITS) {
+        size_t p = partition(a, n, size, cmp, swap);
+        char* left = a;
+        size_t nleft = p;
+        char* right = a + (p + 1) * size;
+        size_t nright = n - p - 1;
+
+        // Hand the smaller half to a thief and keep partitioning the larger.
+        sub[k].task.fn = sort_task_fn;
+        sub[k].size = size;
+        sub[k].cmp = cmp;
+        sub[k].swap = swap;
+        if (nleft < nright) {
+            sub[k].base = left;
+            sub[k].n = nleft;
+            a = right;
+            n = nright;
+        } else {
+            sub[k].base = right;
+            sub[k].n = nright;
+            n = nleft;
+        }
+        task_spawn(&sub[k].task, &pending);
+        ++k;
+    }
+
+    qsort(a, n, size, cmp);
+    task_wait(&pending);
+}
+
+void parallel_qsort(void* base, size_t nmemb, size_t size,
+                    int (*compar)(const void*, const void*)) {
+    if (nmemb < 2 || size == 0) return;
+    ensure_pool();
+    run_sort(base, nmemb, size, compar, pick_swap(size));
+}
@@ -0,0 +1,253 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * task/pool.c
+ * 
+ * Work-stealing worker pool. Each worker owns a deque; idle workers
+ * steal from random victims and, after a short spin, sleep on a futex
+ * until new work is spawned.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <futex.h>
+#include <task.h>
+#include <unistd.h>
+
+#define IDLE_SPINS 256
+#define WORKER_STACK_SIZE (256 * 1024)
+
+struct worker {
+    task_deque deque;
+    pthread_t thread;
+    unsigned int rng;
+};
+
+static struct worker* workers = NULL;
+static int nworkers = 0;
+static atomic_int pool_ready = 0;
+
+static pthread_mutex_t init_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t worker_key;
+
+static atomic_int epoch = 0;
+static atomic_int sleepers = 0;
+static atomic_int stopping = 0;
+
+static void create_key(void) {
+    pthread_key_create(&worker_key, NULL);
+}
+
+static struct worker* current_worker(void) {
+    if (!atomic_load_explicit(&pool_ready, memory_order_acquire))
+        return NULL;
+    uintptr_t id = (uintptr_t)pthread_getspecific(worker_key);
+    return id ? &workers[id - 1] : NULL;
+}
+
+static void wake_all(void);
+
+static void run_task(task_t* t) {
+    // Once pending drops the spawner may reuse t, so read it first.
+    atomic_int* pending = t->pending;
+    t->fn(t);
+    // The last task of a group may have a waiter asleep in task_wait().
+    if (atomic_fetch_sub_explicit(pending, 1, memory_order_release) == 1)
+        wake_all();
+}
+
+static task_t* steal_any(struct worker* self) {
+    unsigned int start = 0;
+    if (self) {
+        self->rng ^= self->rng << 13;
+        self->rng ^= self->rng >> 17;
+        self->rng ^= self->rng << 5;
+        start = self->rng;
+    }
+
+    for (int i = 0; i < nworkers; ++i) {
+        struct worker* victim = &workers[(start + i) % nworkers];
+        if (victim == self) continue;
+        task_t* t = task_deque_steal(&victim->deque);
+        if (t) return t;
+    }
+    return NULL;
+}
+
+static void notify(void) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&sleepers, memory_order_relaxed) > 0) {
+        atomic_fetch_add_explicit(&epoch, 1, memory_order_release);
+        futex_wake((volatile int*)&epoch, 1);
+    }
+}
+
+// Idle workers and task_wait() callers sleep on the same futex, so a
+// finished group has to wake them all to be sure of reaching its waiter.
+static void wake_all(void) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&sleepers, memory_order_relaxed) > 0) {
+        atomic_fetch_add_explicit(&epoch, 1, memory_order_release);
+        futex_wake((volatile int*)&epoch, 0x7fffffff);
+    }
+}
+
+static void* worker_main(void* arg) {
+    struct worker* w = arg;
+    int idle = 0;
+
+    pthread_setspecific(worker_key, (void*)(uintptr_t)(w - workers + 1));
+
+    while (!atomic_load_explicit(&stopping, memory_order_acquire)) {
+        task_t* t = task_deque_pop(&w->deque);
+        if (!t) t = steal_any(w);
+        if (t) {
+            run_task(t);
+            idle = 0;
+            continue;
+        }
+
+        if (++idle < IDLE_SPINS) {
+            cpu_relax();
+            continue;
+        }
+
+        // Announce ourselves as a sleeper, then look once more: a spawner
+        // that missed the announcement must have pushed before we scan.
+        int e = atomic_load_explicit(&epoch, memory_order_acquire);
+        atomic_fetch_add_explicit(&sleepers, 1, memory_order_seq_cst);
+        t = steal_any(w);
+        if (!t && !atomic_load_explicit(&stopping, memory_order_acquire))
+            futex_wait((volatile int*)&epoch, e);
+        atomic_fetch_sub_explicit(&sleepers, 1, memory_order_relaxed);
+
+        if (t) run_task(t);
+        idle = 0;
+    }
+    return NULL;
+}
+
+int task_pool_init(int n) {
+    int ret = 0;
+
+    pthread_once(&key_once, create_key);
+    pthread_mutex_lock(&init_lock);
+    if (atomic_load_explicit(&pool_ready, memory_order_relaxed))
+        goto out;
+
+    if (n < 1) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        n = cpus > 0 ? (int)cpus : TASK_DEFAULT_WORKERS;
+    }
+    if (n > TASK_MAX_WORKERS) n = TASK_MAX_WORKERS;
+
+    workers = malloc(n * sizeof(struct worker));
+    if (!workers) {
+        ret = -1;
+        goto out;
+    }
+    for (int i = 0; i < n; ++i) {
+        task_deque_init(&workers[i].deque);
+        workers[i].rng = 0x9e3779b9u * (i + 1);
+    }
+    nworkers = n;
+    atomic_store_explicit(&stopping, 0, memory_order_relaxed);
+
+    // Slot 0 belongs to the initializing thread, which works while it waits.
+    pthread_setspecific(worker_key, (void*)(uintptr_t)1);
+    atomic_store_explicit(&pool_ready, 1, memory_order_release);
+
+    // Helping while waiting nests tasks on the stack, so workers get
+    // more room than the thread default.
+    pthread_attr_t attr = { WORKER_STACK_SIZE };
+    for (int i = 1; i < n; ++i) {
+        if (pthread_create(&workers[i].thread, &attr, worker_main, &workers[i]) != 0) {
+            // Run with the workers we have; the others' deques stay empty.
+            nworkers = i;
+            break;
+        }
+    }
+
+out:
+    pthread_mutex_unlock(&init_lock);
+    return ret;
+}
+
+void task_pool_shutdown(void) {
+    pthread_mutex_lock(&init_lock);
+    if (!atomic_load_explicit(&pool_ready, memory_order_relaxed)) {
+        pthread_mutex_unlock(&init_lock);
+        return;
+    }
+
+    atomic_store_explicit(&stopping, 1, memory_order_release);
+    atomic_fetch_add_explicit(&epoch, 1, memory_order_release);
+    futex_wake((volatile int*)&epoch, 0x7fffffff);
+
+    for (int i = 1; i < nworkers; ++i)
+        pthread_join(workers[i].thread, NULL);
+
+    atomic_store_explicit(&pool_ready, 0, memory_order_release);
+    pthread_setspecific(worker_key, NULL);
+    free(workers);
+    workers = NULL;
+    nworkers = 0;
+    pthread_mutex_unlock(&init_lock);
+}
+
+int task_pool_size(void) {
+    return nworkers;
+}
+
+void task_spawn(task_t* t, atomic_int* pending) {
+    struct worker* w = current_worker();
+
+    t->pending = pending;
+    atomic_fetch_add_explicit(pending, 1, memory_order_relaxed);
+
+    // Threads outside the pool, and full deques, just run the task here.
+    if (!w || task_deque_push(&w->deque, t) != 0) {
+        run_task(t);
+        return;
+    }
+    notify();
+}
+
+void task_wait(atomic_int* pending) {
+    struct worker* w = current_worker();
+    int idle = 0;
+
+    while (atomic_load_explicit(pending, memory_order_acquire) > 0) {
+        task_t* t = w ? task_deque_pop(&w->deque) : NULL;
+        if (!t) t = steal_any(w);
+        if (t) {
+            run_task(t);
+            idle = 0;
+            continue;
+        }
+
+        if (++idle < IDLE_SPINS) {
+            cpu_relax();
+            continue;
+        }
+
+        // The rest of the group is running elsewhere: sleep as an idle
+        // worker does, and look once more after announcing ourselves.
+        // The task that brings pending to zero sees the announcement.
+        int e = atomic_load_explicit(&epoch, memory_order_acquire);
+        atomic_fetch_add_explicit(&sleepers, 1, memory_order_seq_cst);
+        if (atomic_load_explicit(pending, memory_order_acquire) > 0) {
+            t = steal_any(w);
+            if (!t) futex_wait((volatile int*)&epoch, e);
+        }
+        atomic_fetch_sub_explicit(&sleepers, 1, memory_order_relaxed);
+
+        if (t) run_task(t);
+        idle = 0;
+    }
+}
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * tests/check.c
+ * 
+ * Differential test driver: runs each group against the host libc.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "harness.h"
+
+#define MAX_REPORTS_PER_TEST 5
+
+int failures;
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ull;
+
+uint64_t rng(void) {
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545F4914F6CDD1Dull;
+}
+
+void rng_seed(uint64_t seed) {
+    rng_state = seed ? seed : 1;
+}
+
+static const char* last_test;
+static int reported;
+
+void check_fail(const char* test, const char* file, int line, const char* fmt, ...) {
+    failures++;
+    if (!last_test || strcmp(last_test, test) != 0) {
+        last_test = test;
+        reported = 0;
+    }
+    if (reported++ >= MAX_REPORTS_PER_TEST) return;
+
+    va_list args;
+    va_start(args, fmt);
+    fprintf(stderr, "FAIL %s (%s:%d): ", test, file, line);
+    vfprintf(stderr, fmt, args);
+    fputc('\n', stderr);
+    va_end(args);
+}
+
+static const struct {
+    const char* name;
+    void (*run)(void);
+} groups[] = {
+    { "malloc", test_malloc },
+    { "string", test_string },
+    { "stdio",  test_stdio },
+    { "conv",   test_conv },
+    { "libm",   test_libm },
+    { "thread", test_thread },
+    { "lockfree", test_lockfree },
+    { "sort",   test_sort },
+    { "dirent", test_dirent },
+    { "checksum", test_checksum },
+    { "hashmap", test_hashmap },
+    { "clock",  test_clock },
+    { "spawn",  test_spawn },
+};
+
+int main(int argc, char** argv) {
+    uint64_t seed = argc > 1 ? strtoull(argv[1], NULL, 0) : (uint64_t)time(NULL);
+    printf("seed %llu\n", (unsigned long long)seed);
+    gl_init_heap();
+
+    for (size_t i = 0; i < sizeof(groups) / sizeof(groups[0]); i++) {
+        int before = failures;
+        rng_seed(seed + i);
+        groups[i].run();
+        printf("%-8s %s\n", groups[i].name, failures == before ? "ok" : "FAILED");
+    }
+
+    if (failures) {
+        printf("%d check(s) failed; rerun with `./build/check %llu`\n",
+               failures, (unsigned long long)seed);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,195 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef HARNESS_H
+#define HARNESS_H
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "mirror.h"
+
+/*
+ * The library under test, renamed with a gl_ prefix (see Makefile).
+ * These are declared by hand because the library's own headers can't be
+ * mixed with the host's; the types they use are copied in mirror.h.
+ */
+void gl_init_heap(void);
+void* gl_malloc(size_t size);
+void gl_free(void* ptr);
+void* gl_realloc(void* ptr, size_t size);
+void* gl_calloc(size_t nmemb, size_t size);
+
+void* gl_memset(void* ptr, int value, size_t num);
+void* gl_memcpy(void* dest, const void* src, size_t num);
+int gl_memcmp(const void* a, const void* b, size_t num);
+size_t gl_strlen(const char* s);
+size_t gl_strnlen(const char* s, size_t maxlen);
+int gl_strcmp(const char* a, const char* b);
+char* gl_strchr(const char* s, int c);
+char* gl_strpbrk(const char* s, const char* accept);
+short gl_strspn(const char* s, const char* accept);
+short gl_strcspn(const char* s, const char* reject);
+char* gl_strcpy(char* dest, const char* src);
+char* gl_strncpy(char* dest, const char* src, size_t n);
+char* gl_strcat(char* dest, const char* src);
+char* gl_stpcpy(char* dest, const char* src);
+size_t gl_strlcpy(char* dest, const char* src, size_t size);
+char* gl_strdup(const char* s);
+char* gl_strndup(const char* s, size_t n);
+char* gl_strtok_r(char* s, const char* delim, char** save);
+
+int gl_printf(const char* fmt, ...);
+int gl_sprintf(char* buf, const char* fmt, ...);
+int gl_snprintf(char* buf, size_t size, const char* fmt, ...);
+int gl_vsnprintf(char* buf, size_t size, const char* fmt, va_list args);
+int gl_asprintf(char** strp, const char* fmt, ...);
+
+int gl_atoi(const char* s);
+long gl_atol(const char* s);
+long gl_strtol(const char* s, char** endptr, int base);
+double gl_strtod(const char* s, char** endptr);
+
+double gl_fabs(double x);
+double gl_floor(double x);
+double gl_ceil(double x);
+double gl_fmod(double x, double y);
+double gl_sqrt(double x);
+double gl_exp(double x);
+double gl_log(double x);
+double gl_pow(double x, double y);
+double gl_sin(double x);
+double gl_cos(double x);
+double gl_tan(double x);
+
+void gl_qsort(void* base, size_t nmemb, size_t size, int (*compar)(const void*, const void*));
+void* gl_bsearch(const void* key, const void* base, size_t nmemb, size_t size,
+                 int (*compar)(const void*, const void*));
+int gl_radix_sort_u32(uint32_t* keys, size_t n);
+int gl_radix_sort_u64(uint64_t* keys, size_t n);
+
+uint32_t gl_crc32(uint32_t crc, const void* buf, size_t len);
+uint32_t gl_crc32c(uint32_t crc, const void* buf, size_t len);
+uint32_t gl_adler32(uint32_t adler, const void* buf, size_t len);
+uint64_t gl_xxhash64(const void* buf, size_t len, uint64_t seed);
+
+void gl_sb_init(gl_strbuf* sb);
+void gl_sb_free(gl_strbuf* sb);
+void gl_sb_reset(gl_strbuf* sb);
+int gl_sb_append(gl_strbuf* sb, const char* s);
+int gl_sb_appendc(gl_strbuf* sb, char c);
+int gl_sb_appendf(gl_strbuf* sb, const char* fmt, ...);
+char* gl_sb_detach(gl_strbuf* sb, size_t* len);
+
+void gl_hashmap_init(gl_hashmap* m, const gl_hm_allocator* alloc);
+void gl_hashmap_destroy(gl_hashmap* m);
+int gl_hashmap_reserve(gl_hashmap* m, size_t n);
+void gl_hashmap_clear(gl_hashmap* m);
+void* gl_hashmap_get(const gl_hashmap* m, const void* key, size_t len);
+int gl_hashmap_put(gl_hashmap* m, const void* key, size_t len, void* value);
+int gl_hashmap_remove(gl_hashmap* m, const void* key, size_t len);
+struct gl_hm_slot* gl_hashmap_next(const gl_hashmap* m, size_t* iter);
+
+extern char** gl_environ;
+char* gl_getenv(const char* name);
+int gl_setenv(const char* name, const char* value, int overwrite);
+int gl_unsetenv(const char* name);
+int gl_putenv(char* string);
+
+long gl_sysconf(int name);
+int gl_task_pool_init(int nworkers);
+void gl_task_pool_shutdown(void);
+int gl_task_pool_size(void);
+void gl_parallel_for(size_t begin, size_t end, size_t grain,
+                     void (*fn)(size_t begin, size_t end, void* ctx), void* ctx);
+void gl_parallel_qsort(void* base, size_t nmemb, size_t size,
+                       int (*compar)(const void*, const void*));
+
+gl_DIR* gl_opendir(const char* path);
+struct dirent* gl_readdir(gl_DIR* dir);
+int gl_closedir(gl_DIR* dir);
+int gl_ftw_walk(const char* path,
+                int (*fn)(const char* path, int type, const struct gl_FTW* ftw, void* ctx),
+                void* ctx, int nopenfd, int flags);
+
+int gl_pthread_create(gl_pthread_t* t, const void* attr, void* (*start)(void*), void* arg);
+int gl_pthread_join(gl_pthread_t t, void** result);
+gl_pthread_t gl_pthread_self(void);
+int gl_pthread_key_create(unsigned int* key, void (*destructor)(void*));
+void* gl_pthread_getspecific(unsigned int key);
+int gl_pthread_setspecific(unsigned int key, const void* value);
+int gl_pthread_mutex_lock(gl_mutex_t* m);
+int gl_pthread_mutex_trylock(gl_mutex_t* m);
+int gl_pthread_mutex_unlock(gl_mutex_t* m);
+int gl_pthread_mutex_destroy(gl_mutex_t* m);
+int gl_pthread_cond_wait(gl_cond_t* c, gl_mutex_t* m);
+int gl_pthread_cond_signal(gl_cond_t* c);
+int gl_pthread_cond_broadcast(gl_cond_t* c);
+int gl_pthread_once(gl_once_t* once, void (*fn)(void));
+int gl_pthread_rwlock_rdlock(gl_rwlock_t* rw);
+int gl_pthread_rwlock_wrlock(gl_rwlock_t* rw);
+int gl_pthread_rwlock_unlock(gl_rwlock_t* rw);
+int gl_pthread_rwlock_destroy(gl_rwlock_t* rw);
+
+int gl_lf_queue_init(gl_lf_queue* q, size_t capacity);
+void gl_lf_queue_destroy(gl_lf_queue* q);
+int gl_lf_queue_push(gl_lf_queue* q, void* data);
+int gl_lf_queue_pop(gl_lf_queue* q, void** data);
+void gl_lf_stack_push(gl_lf_stack* s, struct gl_lf_node* node);
+struct gl_lf_node* gl_lf_stack_pop(gl_lf_stack* s);
+struct gl_lf_node* gl_lf_stack_pop_all(gl_lf_stack* s);
+int gl_lf_stack_empty(gl_lf_stack* s);
+
+void gl___clock_init(void);
+int gl_clock_gettime(int clk, struct gl_timespec* ts);
+long gl_time(long* t);
+
+int gl_posix_spawn_file_actions_init(gl_posix_spawn_file_actions_t* fa);
+int gl_posix_spawn_file_actions_destroy(gl_posix_spawn_file_actions_t* fa);
+int gl_posix_spawn_file_actions_adddup2(gl_posix_spawn_file_actions_t* fa, int fd, int newfd);
+int gl_posix_spawn_file_actions_addclose(gl_posix_spawn_file_actions_t* fa, int fd);
+int gl_posix_spawn_file_actions_addopen(gl_posix_spawn_file_actions_t* fa, int fd,
+                                        const char* path, int oflag, unsigned int mode);
+int gl_posix_spawn(int* pid, const char* path, const gl_posix_spawn_file_actions_t* fa,
+                   const void* attr, char* const argv[], char* const envp[]);
+int gl_waitpid(int pid, int* status, int options);
+
+// stdlib/memory.c's lock, made global by the Makefile so tests can hold
+// it and force free() onto its deferred path.
+extern gl_mutex_t gl_heap_lock;
+
+// shim.c: SYS_PRINT output goes to stdout unless captured.
+void shim_capture_begin(void);
+const char* shim_capture_end(void);
+
+// Reporting. CHECK records a failure and carries on; the first few of
+// each test are printed.
+extern int failures;
+void check_fail(const char* test, const char* file, int line, const char* fmt, ...)
+    __attribute__((format(printf, 4, 5)));
+
+#define CHECK(test, cond, ...) \
+    do { if (!(cond)) check_fail((test), __FILE__, __LINE__, __VA_ARGS__); } while (0)
+
+// Deterministic xorshift64*; the seed is printed so runs can be replayed.
+uint64_t rng(void);
+void rng_seed(uint64_t seed);
+
+static inline int sign(int v) {
+    return (v > 0) - (v < 0);
+}
+
+void test_string(void);
+void test_stdio(void);
+void test_conv(void);
+void test_libm(void);
+void test_thread(void);
+void test_lockfree(void);
+void test_sort(void);
+void test_dirent(void);
+void test_checksum(void);
+void test_hashmap(void);
+void test_malloc(void);
+void test_clock(void);
+void test_spawn(void);
+
+#endif // HARNESS_H
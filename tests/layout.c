@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * tests/layout.c
+ *
+ * Compile-time check that the copies in mirror.h still match the
+ * library's headers. Built with the library's flags; nothing in it
+ * runs, so a mismatch fails the build instead of corrupting a test.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <stddef.h>
+#include <strbuf.h>
+#include <hashmap.h>
+#include <dirent.h>
+#include <ftw.h>
+#include <pthread.h>
+#include <lockfree.h>
+#include <time.h>
+#include <fcntl.h>
+#include <spawn.h>
+#include "mirror.h"
+
+#define SAME_SIZE(lib, mirror) \
+    _Static_assert(sizeof(lib) == sizeof(mirror), "size of " #mirror)
+#define SAME_FIELD(lib, mirror, field) \
+    _Static_assert(offsetof(lib, field) == offsetof(mirror, field), #mirror "." #field)
+#define SAME_VALUE(lib, mirror) \
+    _Static_assert((lib) == (mirror), #mirror)
+
+SAME_SIZE(strbuf, gl_strbuf);
+SAME_FIELD(strbuf, gl_strbuf, data);
+SAME_FIELD(strbuf, gl_strbuf, len);
+SAME_FIELD(strbuf, gl_strbuf, cap);
+SAME_FIELD(strbuf, gl_strbuf, inline_buf);
+
+SAME_SIZE(hm_allocator, gl_hm_allocator);
+SAME_FIELD(hm_allocator, gl_hm_allocator, alloc);
+SAME_FIELD(hm_allocator, gl_hm_allocator, free);
+SAME_FIELD(hm_allocator, gl_hm_allocator, ctx);
+SAME_SIZE(struct hm_slot, struct gl_hm_slot);
+SAME_FIELD(struct hm_slot, struct gl_hm_slot, key);
+SAME_FIELD(struct hm_slot, struct gl_hm_slot, len);
+SAME_FIELD(struct hm_slot, struct gl_hm_slot, value);
+SAME_SIZE(hashmap, gl_hashmap);
+SAME_FIELD(hashmap, gl_hashmap, ctrl);
+SAME_FIELD(hashmap, gl_hashmap, slots);
+SAME_FIELD(hashmap, gl_hashmap, capacity);
+SAME_FIELD(hashmap, gl_hashmap, size);
+SAME_FIELD(hashmap, gl_hashmap, growth_left);
+SAME_FIELD(hashmap, gl_hashmap, seed);
+SAME_FIELD(hashmap, gl_hashmap, alloc);
+
+SAME_SIZE(DIR, gl_DIR);
+SAME_FIELD(DIR, gl_DIR, fd);
+SAME_FIELD(DIR, gl_DIR, pos);
+SAME_FIELD(DIR, gl_DIR, len);
+SAME_FIELD(DIR, gl_DIR, size);
+SAME_FIELD(DIR, gl_DIR, buf);
+SAME_FIELD(DIR, gl_DIR, error);
+
+SAME_SIZE(struct FTW, struct gl_FTW);
+SAME_FIELD(struct FTW, struct gl_FTW, base);
+SAME_FIELD(struct FTW, struct gl_FTW, level);
+SAME_VALUE(FTW_F, GL_FTW_F);
+SAME_VALUE(FTW_D, GL_FTW_D);
+SAME_VALUE(FTW_DNR, GL_FTW_DNR);
+SAME_VALUE(FTW_NS, GL_FTW_NS);
+SAME_VALUE(FTW_SL, GL_FTW_SL);
+SAME_VALUE(FTW_DP, GL_FTW_DP);
+SAME_VALUE(FTW_DEPTH, GL_FTW_DEPTH);
+
+SAME_SIZE(pthread_t, gl_pthread_t);
+SAME_SIZE(pthread_mutex_t, gl_mutex_t);
+SAME_FIELD(pthread_mutex_t, gl_mutex_t, state);
+SAME_SIZE(pthread_cond_t, gl_cond_t);
+SAME_FIELD(pthread_cond_t, gl_cond_t, seq);
+SAME_SIZE(pthread_once_t, gl_once_t);
+SAME_SIZE(pthread_rwlock_t, gl_rwlock_t);
+SAME_FIELD(pthread_rwlock_t, gl_rwlock_t, state);
+SAME_FIELD(pthread_rwlock_t, gl_rwlock_t, waiters);
+SAME_FIELD(pthread_rwlock_t, gl_rwlock_t, writers_waiting);
+
+SAME_SIZE(struct lf_cell, struct gl_lf_cell);
+SAME_FIELD(struct lf_cell, struct gl_lf_cell, seq);
+SAME_FIELD(struct lf_cell, struct gl_lf_cell, data);
+SAME_SIZE(lf_queue, gl_lf_queue);
+SAME_FIELD(lf_queue, gl_lf_queue, cells);
+SAME_FIELD(lf_queue, gl_lf_queue, mask);
+SAME_FIELD(lf_queue, gl_lf_queue, enqueue_pos);
+SAME_FIELD(lf_queue, gl_lf_queue, dequeue_pos);
+SAME_SIZE(struct lf_node, struct gl_lf_node);
+SAME_FIELD(struct lf_node, struct gl_lf_node, next);
+SAME_SIZE(lf_stack, gl_lf_stack);
+SAME_FIELD(lf_stack, gl_lf_stack, head);
+
+SAME_SIZE(struct timespec, struct gl_timespec);
+SAME_FIELD(struct timespec, struct gl_timespec, tv_sec);
+SAME_FIELD(struct timespec, struct gl_timespec, tv_nsec);
+SAME_VALUE(CLOCK_REALTIME, GL_CLOCK_REALTIME);
+SAME_VALUE(CLOCK_MONOTONIC, GL_CLOCK_MONOTONIC);
+
+SAME_SIZE(posix_spawn_file_actions_t, gl_posix_spawn_file_actions_t);
+SAME_FIELD(posix_spawn_file_actions_t, gl_posix_spawn_file_actions_t, count);
+SAME_FIELD(posix_spawn_file_actions_t, gl_posix_spawn_file_actions_t, cap);
+SAME_FIELD(posix_spawn_file_actions_t, gl_posix_spawn_file_actions_t, actions);
+SAME_VALUE(O_RDONLY, GL_O_RDONLY);
+SAME_VALUE(O_WRONLY, GL_O_WRONLY);
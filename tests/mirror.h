@@ -0,0 +1,115 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+
+#ifndef MIRROR_H
+#define MIRROR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Copies of the library's public types and constants, under gl_ names,
+ * for tests that can't include the library's headers next to the
+ * host's. Only stddef.h and stdint.h are used here, so layout.c can
+ * include this beside the real headers and check that the two agree.
+ */
+
+// Layout mirrors include/strbuf.h.
+typedef struct {
+    char* data;
+    size_t len;
+    size_t cap;
+    char inline_buf[64];
+} gl_strbuf;
+
+// Layouts mirror include/hashmap.h.
+typedef struct {
+    void* (*alloc)(void* ctx, size_t size);
+    void (*free)(void* ctx, void* ptr, size_t size);
+    void* ctx;
+} gl_hm_allocator;
+
+struct gl_hm_slot {
+    const void* key;
+    size_t len;
+    void* value;
+};
+
+typedef struct {
+    int8_t* ctrl;
+    struct gl_hm_slot* slots;
+    size_t capacity, size, growth_left;
+    uint64_t seed;
+    gl_hm_allocator alloc;
+} gl_hashmap;
+
+// Layouts and values mirror include/dirent.h and include/ftw.h.
+typedef struct {
+    int fd;
+    size_t pos, len, size;
+    char* buf;
+    int error;
+} gl_DIR;
+
+struct gl_FTW {
+    int base, level;
+};
+
+#define GL_FTW_F     0
+#define GL_FTW_D     1
+#define GL_FTW_DNR   2
+#define GL_FTW_NS    3
+#define GL_FTW_SL    4
+#define GL_FTW_DP    5
+#define GL_FTW_DEPTH 8
+
+// Layouts mirror include/pthread.h.
+typedef struct gl_pthread* gl_pthread_t;
+typedef struct { volatile int state; } gl_mutex_t;
+typedef struct { volatile int seq; } gl_cond_t;
+typedef volatile int gl_once_t;
+typedef struct { volatile int state, waiters, writers_waiting; } gl_rwlock_t;
+
+// Layouts mirror include/lockfree.h.
+struct gl_lf_cell {
+    size_t seq;
+    void* data;
+};
+
+typedef struct {
+    struct gl_lf_cell* cells;
+    size_t mask;
+    char pad0[64];
+    size_t enqueue_pos;
+    char pad1[64 - sizeof(size_t)];
+    size_t dequeue_pos;
+    char pad2[64 - sizeof(size_t)];
+} gl_lf_queue;
+
+struct gl_lf_node {
+    struct gl_lf_node* next;
+};
+
+typedef struct {
+    volatile uint64_t head;
+} gl_lf_stack;
+
+// Layout and values mirror include/time.h.
+struct gl_timespec {
+    long tv_sec;
+    long tv_nsec;
+};
+
+#define GL_CLOCK_REALTIME  0
+#define GL_CLOCK_MONOTONIC 1
+
+// Layout mirrors include/spawn.h; values mirror include/fcntl.h.
+typedef struct {
+    int count;
+    int cap;
+    void* actions;
+} gl_posix_spawn_file_actions_t;
+
+#define GL_O_RDONLY 1
+#define GL_O_WRONLY 2
+
+#endif // MIRROR_H
@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * tests/shim.c
+ * 
+ * Maps Goldspace syscall numbers onto Linux for hosted builds.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#define _GNU_SOURCE
+#undef _FORTIFY_SOURCE  // longjmp below leaves one stack for another
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <setjmp.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <linux/futex.h>
+
+// Goldspace numbers, from include/syscall.h
+enum {
+    G_OPEN = 0, G_WRITE = 1, G_READ = 2, G_CLOSE = 3, G_SPAWN = 4,
+    G_EXIT = 6, G_STAT = 7, G_PRINT = 8, G_THREAD_CREATE = 9,
+    G_THREAD_EXIT = 10, G_FUTEX_WAIT = 11, G_FUTEX_WAKE = 12,
+    G_SET_TLS = 13, G_YIELD = 14, G_CLOCK_GETTIME = 15, G_WAITPID = 16,
+    G_PIPE = 17, G_DUP2 = 18, G_FCNTL = 19, G_GETDENTS = 20, G_NPROCS = 21
+};
+
+static char* capture_buf;
+static size_t capture_len, capture_cap;
+static int capturing;
+
+void shim_capture_begin(void) {
+    capture_len = 0;
+    capturing = 1;
+}
+
+const char* shim_capture_end(void) {
+    capturing = 0;
+    if (!capture_buf) return "";
+    capture_buf[capture_len] = '\0';
+    return capture_buf;
+}
+
+static long print(const char* s) {
+    size_t n = strlen(s);
+    if (!capturing) return write(1, s, n);
+    if (capture_len + n + 1 > capture_cap) {
+        capture_cap = (capture_len + n + 1) * 2;
+        capture_buf = realloc(capture_buf, capture_cap);
+    }
+    memcpy(capture_buf + capture_len, s, n);
+    capture_len += n;
+    return (long)n;
+}
+
+/*
+ * Library threads run on host threads. The host thread jumps onto the
+ * stack the library allocated and enters at its thread entry point;
+ * SYS_THREAD_EXIT jumps back, and only then is the exit reported, since
+ * the joiner frees that stack.
+ */
+struct thread_start {
+    long entry, sp;
+};
+
+static __thread jmp_buf thread_exit_jmp;
+static __thread volatile int* thread_clear;
+
+static void* thread_main(void* arg) {
+    struct thread_start st = *(struct thread_start*)arg;
+    free(arg);
+
+    if (!setjmp(thread_exit_jmp)) {
+#if defined(__x86_64__)
+        __asm__ volatile ("movq %0, %%rsp\n\tjmp *%1" : : "r"(st.sp), "r"(st.entry) : "memory");
+#else
+        __asm__ volatile ("movl %0, %%esp\n\tjmp *%1" : : "r"(st.sp), "r"(st.entry) : "memory");
+#endif
+        __builtin_unreachable();
+    }
+
+    __atomic_store_n(thread_clear, 0, __ATOMIC_RELEASE);
+    syscall(SYS_futex, thread_clear, FUTEX_WAKE_PRIVATE, INT_MAX);
+    return NULL;
+}
+
+static long thread_create(long entry, long sp) {
+    struct thread_start* st = malloc(sizeof(*st));
+    if (!st) return -1;
+    st->entry = entry;
+    st->sp = sp;
+
+    pthread_attr_t attr;
+    pthread_t t;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    int err = pthread_create(&t, &attr, thread_main, st);
+    pthread_attr_destroy(&attr);
+    if (err) {
+        free(st);
+        return -1;
+    }
+    return 1;
+}
+
+static long thread_exit(long clear_addr) {
+    thread_clear = (volatile int*)clear_addr;
+    longjmp(thread_exit_jmp, 1);
+}
+
+// include/fcntl.h: O_RDONLY 1, O_WRONLY 2, O_RDWR 3, and the
+// O_NONBLOCK/O_DIRECTORY/O_NOFOLLOW bits
+static int open_flags(long g) {
+    int f;
+    switch (g & 3) {
+        case 1: f = O_RDONLY; break;
+        case 2: f = O_WRONLY | O_CREAT | O_TRUNC; break;
+        default: f = O_RDWR | O_CREAT; break;
+    }
+    if (g & 0x800) f |= O_NONBLOCK;
+    if (g & 0x10000) f |= O_DIRECTORY;
+    if (g & 0x20000) f |= O_NOFOLLOW;
+    return f;
+}
+
+static long ret(long r) {
+    return r < 0 ? -1 : r;
+}
+
+// The child inherits the descriptor table as it stands, which is what
+// posix_spawn's file actions rely on. A path that can't be executed
+// fails here, as the kernel's spawn would; a later exec failure exits
+// 127, like the shell.
+static long spawn(const char* path, char* const argv[], char* const envp[]) {
+    if (access(path, X_OK) != 0) return -1;
+    pid_t pid = fork();
+    if (pid == 0) {
+        execve(path, argv, envp ? envp : environ);
+        _exit(127);
+    }
+    return ret(pid);
+}
+
+long __hosted_syscall(long n, long a, long b, long c) {
+    switch (n) {
+        case G_OPEN:          return ret(open((const char*)a, open_flags(b), 0644));
+        case G_WRITE:         return ret(write((int)a, (const void*)b, (size_t)c));
+        case G_READ:          return ret(read((int)a, (void*)b, (size_t)c));
+        case G_CLOSE:         return ret(close((int)a));
+        case G_SPAWN:         return spawn((const char*)a, (char* const*)b, (char* const*)c);
+        case G_EXIT:          _exit((int)a);
+        case G_PRINT:         return print((const char*)a);
+        case G_THREAD_CREATE: return thread_create(a, b);
+        case G_THREAD_EXIT:   return thread_exit(a);
+        case G_FUTEX_WAIT:    return ret(syscall(SYS_futex, a, FUTEX_WAIT_PRIVATE, b, NULL));
+        case G_FUTEX_WAKE:    return ret(syscall(SYS_futex, a, FUTEX_WAKE_PRIVATE, b));
+        case G_SET_TLS:       return 0;  // see thread.c: hosted builds use __thread
+        case G_YIELD:         return sched_yield();
+        case G_CLOCK_GETTIME: return ret(clock_gettime((clockid_t)a, (struct timespec*)b));
+        case G_WAITPID:       return ret(waitpid((pid_t)a, (int*)b, (int)c));
+        case G_PIPE:          return ret(pipe((int*)a));
+        case G_DUP2:          return ret(dup2((int)a, (int)b));
+        case G_FCNTL:         return ret(fcntl((int)a, (int)b, c));
+        case G_GETDENTS:      return ret(syscall(SYS_getdents64, a, b, c));
+        case G_NPROCS:        return ret(sysconf(_SC_NPROCESSORS_ONLN));
+        default:              return -1;  // stat: not mapped
+    }
+}
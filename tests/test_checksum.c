@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * tests/test_checksum.c
+ *
+ * CRC32 and Adler-32 against the host's zlib, CRC32C against a bitwise
+ * reference, and xxHash64 against the reference implementation's
+ * published values. Random lengths and offsets reach every head, body
+ * and tail path of the SIMD kernels.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <string.h>
+#include <zlib.h>
+#include "harness.h"
+
+#define ITERS   2000
+#define BUF     (16384 + 64)
+
+static unsigned char buf[BUF], copy[BUF];
+
+static uint32_t crc32c_ref(uint32_t crc, const unsigned char* p, size_t len) {
+    crc = ~crc;
+    while (len--) {
+        crc ^= *p++;
+        for (int k = 0; k < 8; k++)
+            crc = crc & 1 ? (crc >> 1) ^ 0x82f63b78u : crc >> 1;
+    }
+    return ~crc;
+}
+
+static void check_vectors(void) {
+    const char* digits = "123456789";
+    CHECK("crc32", gl_crc32(0, digits, 9) == 0xCBF43926u, "check value %08x", gl_crc32(0, digits, 9));
+    CHECK("crc32c", gl_crc32c(0, digits, 9) == 0xE3069283u, "check value %08x", gl_crc32c(0, digits, 9));
+    CHECK("adler32", gl_adler32(1, "Wikipedia", 9) == 0x11E60398u, "check value %08x",
+          gl_adler32(1, "Wikipedia", 9));
+    CHECK("crc32", gl_crc32(0, NULL, 0) == 0, "empty buffer");
+    CHECK("adler32", gl_adler32(1, NULL, 0) == 1, "empty buffer");
+
+    static const struct {
+        const char* s;
+        uint64_t seed, want;
+    } xxh[] = {
+        { "", 0, 0xEF46DB3751D8E999ull },
+        { "a", 0, 0xD24EC4F1A98C6E5Bull },
+        { "abc", 0, 0x44BC2CF5AD770999ull },
+        { "123456789", 0, 0x8CB841DB40E6AE83ull },
+        { "The quick brown fox jumps over the lazy dog", 0, 0x0B242D361FDA71BCull },
+        { "The quick brown fox jumps over the lazy dog", 1, 0xDF5091B6DAD2C6DBull },
+    };
+    for (size_t i = 0; i < sizeof(xxh) / sizeof(xxh[0]); i++) {
+        uint64_t got = gl_xxhash64(xxh[i].s, strlen(xxh[i].s), xxh[i].seed);
+        CHECK("xxhash64", got == xxh[i].want, "\"%s\" seed %llu: %016llx", xxh[i].s,
+              (unsigned long long)xxh[i].seed, (unsigned long long)got);
+    }
+
+    // Long enough for the four-lane loop.
+    unsigned char seq[1024];
+    for (int i = 0; i < 1024; i++) seq[i] = (unsigned char)i;
+    CHECK("xxhash64", gl_xxhash64(seq, 1024, 0) == 0x6F3914F18FE4DF57ull, "1024 bytes 0..255");
+    CHECK("xxhash64", gl_xxhash64(seq, 100, 0x9E3779B97F4A7C15ull) == 0x3B97D91EBA03E785ull,
+          "100 bytes, 64-bit seed");
+}
+
+static size_t rand_len(void) {
+    switch (rng() % 4) {
+        case 0:  return rng() % 16384;
+        case 1:  return rng() % 16;
+        default: return rng() % 512;
+    }
+}
+
+static void check_random(void) {
+    for (size_t i = 0; i < BUF; i++) buf[i] = (unsigned char)rng();
+
+    for (int it = 0; it < ITERS; it++) {
+        size_t len = rand_len(), off = rng() % 64;
+        const unsigned char* p = buf + off;
+
+        uint32_t got = gl_crc32(0, p, len), want = (uint32_t)crc32(0, p, len);
+        CHECK("crc32", got == want, "len %zu off %zu: %08x vs %08x", len, off, got, want);
+        got = gl_crc32c(0, p, len);
+        want = crc32c_ref(0, p, len);
+        CHECK("crc32c", got == want, "len %zu off %zu: %08x vs %08x", len, off, got, want);
+        got = gl_adler32(1, p, len);
+        want = (uint32_t)adler32(1, p, len);
+        CHECK("adler32", got == want, "len %zu off %zu: %08x vs %08x", len, off, got, want);
+
+        // Split anywhere and carry the state across.
+        size_t cut = len ? rng() % len : 0;
+        CHECK("crc32", gl_crc32(gl_crc32(0, p, cut), p + cut, len - cut) == gl_crc32(0, p, len),
+              "len %zu split at %zu", len, cut);
+        CHECK("crc32c", gl_crc32c(gl_crc32c(0, p, cut), p + cut, len - cut) == gl_crc32c(0, p, len),
+              "len %zu split at %zu", len, cut);
+        CHECK("adler32", gl_adler32(gl_adler32(1, p, cut), p + cut, len - cut) == gl_adler32(1, p, len),
+              "len %zu split at %zu", len, cut);
+
+        // xxHash64 must not depend on where the bytes sit.
+        uint64_t seed = rng();
+        memcpy(copy + (off ^ 7), p, len);
+        CHECK("xxhash64", gl_xxhash64(p, len, seed) == gl_xxhash64(copy + (off ^ 7), len, seed),
+              "len %zu: offsets %zu and %zu differ", len, off, off ^ 7);
+    }
+
+    // All-0xff input drives Adler-32's sums to their largest values
+    // between reductions.
+    memset(buf, 0xff, BUF);
+    CHECK("adler32", gl_adler32(1, buf, BUF) == (uint32_t)adler32(1, buf, BUF), "all 0xff");
+}
+
+void test_checksum(void) {
+    check_vectors();
+    check_random();
+}
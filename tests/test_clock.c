@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * tests/test_clock.c
+ *
+ * clock_gettime's TSC fast path against the host clock, which is what
+ * the syscall path returns here: reads must never go backwards, and
+ * must stay close to the host's over a few recalibrations.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <time.h>
+#include <unistd.h>
+#include "harness.h"
+
+#define SPAN_NS     2500000000ll    // runs past two recalibrations
+#define TOLERANCE   200000ll        // 200 us, for a busy or virtual machine
+
+static long long host_ns(clockid_t clk) {
+    struct timespec ts;
+    clock_gettime(clk, &ts);
+    return ts.tv_sec * 1000000000ll + ts.tv_nsec;
+}
+
+static long long gl_ns(int clk) {
+    struct gl_timespec ts;
+    if (gl_clock_gettime(clk, &ts) != 0) return -1;
+    return ts.tv_sec * 1000000000ll + ts.tv_nsec;
+}
+
+static void check_drift(void) {
+    long long start = host_ns(CLOCK_MONOTONIC), last = 0, worst = 0;
+    long backwards = 0, reads = 0;
+
+    while (host_ns(CLOCK_MONOTONIC) - start < SPAN_NS) {
+        // A burst of reads, so some land on either side of a re-anchor.
+        for (int i = 0; i < 1000; i++, reads++) {
+            long long t = gl_ns(GL_CLOCK_MONOTONIC);
+            if (t < last) backwards++;
+            last = t;
+        }
+
+        long long before = host_ns(CLOCK_MONOTONIC);
+        long long t = gl_ns(GL_CLOCK_MONOTONIC);
+        long long after = host_ns(CLOCK_MONOTONIC);
+        long long err = t < before ? before - t : t > after ? t - after : 0;
+        if (err > worst) worst = err;
+        if (t > last) last = t;
+        usleep(10000);
+    }
+    CHECK("clock_gettime", backwards == 0, "CLOCK_MONOTONIC went back %ld times in %ld reads",
+          backwards, reads);
+    CHECK("clock_gettime", worst <= TOLERANCE, "CLOCK_MONOTONIC %lld ns off the host clock", worst);
+
+    long long before = host_ns(CLOCK_REALTIME);
+    long long t = gl_ns(GL_CLOCK_REALTIME);
+    long long after = host_ns(CLOCK_REALTIME);
+    CHECK("clock_gettime", t >= before - TOLERANCE && t <= after + TOLERANCE,
+          "CLOCK_REALTIME %lld ns, host between %lld and %lld", t, before, after);
+
+    long now = (long)time(NULL);
+    long got = gl_time(NULL);
+    CHECK("time", got >= now && got <= now + 1, "%ld, host %ld", got, now);
+}
+
+void test_clock(void) {
+    // crt0 does this in a real program.
+    gl___clock_init();
+    check_drift();
+}
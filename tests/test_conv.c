@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * tests/test_conv.c
+ * 
+ * atoi/atol/strtol/strtod against the host.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "harness.h"
+
+#define ITERS 50000
+
+// strtod rounds the mantissa and then the power-of-ten scaling, so it
+// isn't correctly rounded; this is the error it is allowed, in units in
+// the last place.
+#define STRTOD_MAX_ULP 1
+
+static const char digits36[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+static void rand_number(char* p, int base, int ndigits) {
+    static const char* const ws[] = { "", " ", "\t", "  \n", "\v\f\r " };
+    static const char* const signs[] = { "", "", "-", "+" };
+    p += sprintf(p, "%s%s", ws[rng() % 5], signs[rng() % 4]);
+    if ((base == 16 || base == 0) && rng() % 2) p += sprintf(p, rng() % 2 ? "0x" : "0X");
+    else if (base == 0 && rng() % 3 == 0) *p++ = '0';
+    int b = base ? base : 10;
+    for (int i = 0; i < ndigits; i++) {
+        char c = digits36[rng() % b];
+        *p++ = rng() % 2 ? c : (char)(c >= 'a' ? c - 32 : c);
+    }
+    // Trailing junk, sometimes a digit that's out of range for the base
+    static const char* const tails[] = { "", "", "z", " 12", ".5", "9" };
+    strcpy(p, tails[rng() % 6]);
+}
+
+static void test_strtol(void) {
+    char buf[128];
+    static const char* const edge[] = {
+        "", " ", "-", "+", "0x", "0X", "0xg", "-0x", "0", "-0", "00", "08", "0b1",
+        "9223372036854775807", "9223372036854775808", "-9223372036854775808",
+        "-9223372036854775809", "99999999999999999999999", "2147483648",
+        "zz", "  +z", "\t-7f"
+    };
+    static const int bases[] = { 0, 2, 8, 10, 16, 36 };
+
+    for (size_t i = 0; i < sizeof(edge) / sizeof(edge[0]); i++) {
+        for (size_t j = 0; j < sizeof(bases) / sizeof(bases[0]); j++) {
+            char *ge, *we;
+            long g = gl_strtol(edge[i], &ge, bases[j]);
+            long w = strtol(edge[i], &we, bases[j]);
+            CHECK("strtol edge", g == w && ge == we, "\"%s\" base %d: %ld/+%td, want %ld/+%td",
+                  edge[i], bases[j], g, ge - edge[i], w, we - edge[i]);
+        }
+    }
+
+    for (int it = 0; it < ITERS; it++) {
+        int base = rng() % 4 ? (int)(rng() % 35) + 2 : 0;
+        if (base == 1) base = 0;
+        rand_number(buf, base, (int)(rng() % 24));
+        char *ge, *we;
+        long g = gl_strtol(buf, &ge, base);
+        long w = strtol(buf, &we, base);
+        CHECK("strtol", g == w && ge == we, "\"%s\" base %d: %ld/+%td, want %ld/+%td",
+              buf, base, g, ge - buf, w, we - buf);
+    }
+}
+
+static void test_atoi(void) {
+    char buf[64];
+    for (int it = 0; it < ITERS; it++) {
+        int v = (int)rng();
+        if (v == INT_MIN) v++;
+        sprintf(buf, rng() % 2 ? "%d" : "  %d!", v);
+        CHECK("atoi", gl_atoi(buf) == atoi(buf), "\"%s\"", buf);
+
+        long l = (long)rng();
+        if (l == LONG_MIN) l++;
+        sprintf(buf, "%ld", l);
+        CHECK("atol", gl_atol(buf) == atol(buf), "\"%s\"", buf);
+    }
+}
+
+static uint64_t ulp_distance(double a, double b) {
+    int64_t ia, ib;
+    memcpy(&ia, &a, 8);
+    memcpy(&ib, &b, 8);
+    if (ia < 0) ia = INT64_MIN - ia;
+    if (ib < 0) ib = INT64_MIN - ib;
+    return ia > ib ? (uint64_t)(ia - ib) : (uint64_t)(ib - ia);
+}
+
+static void test_strtod(void) {
+    char buf[128];
+    static const char* const edge[] = {
+        "", "-", "+", ".", "-.", "0", "-0", "0.", ".5", "-.5", "1.", "  +12.5xyz",
+        "0.1", "0.2", "0.3", "123456789012345678", "3.141592653589793",
+        "0.000000000000000000001", "1e5", "abc"
+    };
+
+    for (size_t i = 0; i < sizeof(edge) / sizeof(edge[0]); i++) {
+        char *ge, *we;
+        double g = gl_strtod(edge[i], &ge);
+        double w = strtod(edge[i], &we);
+        CHECK("strtod edge", ge == we && ulp_distance(g, w) <= STRTOD_MAX_ULP,
+              "\"%s\": %.17g/+%td, want %.17g/+%td", edge[i], g, ge - edge[i], w, we - edge[i]);
+        CHECK("strtod edge", signbit(g) == signbit(w), "\"%s\": sign", edge[i]);
+    }
+
+    uint64_t worst = 0;
+    for (int it = 0; it < ITERS; it++) {
+        // Up to 17 significant digits, split around a decimal point
+        char* p = buf;
+        if (rng() % 2) *p++ = '-';
+        int ni = (int)(rng() % 10), nf = (int)(rng() % (18 - ni));
+        for (int i = 0; i < ni; i++) *p++ = (char)('0' + rng() % 10);
+        if (nf || rng() % 2) *p++ = '.';
+        for (int i = 0; i < nf; i++) *p++ = (char)('0' + rng() % 10);
+        *p = '\0';
+
+        char *ge, *we;
+        double g = gl_strtod(buf, &ge);
+        double w = strtod(buf, &we);
+        uint64_t d = ulp_distance(g, w);
+        if (d > worst) worst = d;
+        CHECK("strtod", ge == we && d <= STRTOD_MAX_ULP, "\"%s\": %.17g (%llu ulp), want %.17g",
+              buf, g, (unsigned long long)d, w);
+    }
+    if (getenv("CHECK_VERBOSE"))
+        printf("  strtod: max %llu ulp\n", (unsigned long long)worst);
+}
+
+void test_conv(void) {
+    test_strtol();
+    test_atoi();
+    test_strtod();
+}
@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * tests/test_dirent.c
+ *
+ * readdir and ftw_walk over a scratch tree, checked against the host's
+ * nftw with FTW_PHYS.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <ftw.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "harness.h"
+
+#define DEPTH 12
+
+static char root[64];
+
+static void touch(const char* path) {
+    int fd = open(path, O_WRONLY | O_CREAT, 0644);
+    if (fd >= 0) close(fd);
+}
+
+// root/d0/d1/.../d11, each holding a file; a link to d0 and a FIFO at
+// the top.
+static void make_tree(void) {
+    char path[512];
+    strcpy(root, "/tmp/gl_ftw.XXXXXX");
+    if (!mkdtemp(root)) return;
+
+    size_t len = (size_t)snprintf(path, sizeof(path), "%s", root);
+    for (int i = 0; i < DEPTH; i++) {
+        len += (size_t)snprintf(path + len, sizeof(path) - len, "/d%d", i);
+        mkdir(path, 0755);
+        snprintf(path + len, sizeof(path) - len, "/f");
+        touch(path);
+        path[len] = '\0';
+    }
+    snprintf(path, sizeof(path), "%s/link", root);
+    symlink("d0", path);
+    snprintf(path, sizeof(path), "%s/fifo", root);
+    mkfifo(path, 0644);
+}
+
+static int remove_one(const char* path, const struct stat* st, int type, struct FTW* ftw) {
+    (void)st;
+    (void)ftw;
+    return type == FTW_DP ? rmdir(path) : unlink(path);
+}
+
+// Tallies by type, and the most descriptors seen open at once.
+struct tally {
+    int count[6];
+    int max_open;
+    int stop_after;
+};
+
+static struct tally host;
+
+static int host_visit(const char* path, const struct stat* st, int type, struct FTW* ftw) {
+    (void)path;
+    (void)st;
+    (void)ftw;
+    int t = type == FTW_D ? GL_FTW_D : type == FTW_SL ? GL_FTW_SL : GL_FTW_F;
+    host.count[t]++;
+    return 0;
+}
+
+static int open_fds(void) {
+    int n = 0;
+    for (int fd = 0; fd < 256; fd++)
+        if (fcntl(fd, F_GETFD) >= 0) n++;
+    return n;
+}
+
+static int gl_visit(const char* path, int type, const struct gl_FTW* ftw, void* ctx) {
+    struct tally* t = ctx;
+    (void)path;
+    (void)ftw;
+    t->count[type]++;
+    int n = open_fds();
+    if (n > t->max_open) t->max_open = n;
+    return t->stop_after && --t->stop_after == 0 ? 42 : 0;
+}
+
+static void check_walk(void) {
+    nftw(root, host_visit, 64, FTW_PHYS);
+    int base_fds = open_fds();
+
+    int limits[] = { 1, 2, 5, 64 };
+    for (size_t i = 0; i < sizeof(limits) / sizeof(limits[0]); i++) {
+        struct tally t = { { 0 } };
+        int r = gl_ftw_walk(root, gl_visit, &t, limits[i], 0);
+        CHECK("ftw_walk", r == 0, "nopenfd %d: returned %d", limits[i], r);
+        CHECK("ftw_walk", t.count[GL_FTW_D] == host.count[GL_FTW_D] &&
+                          t.count[GL_FTW_F] == host.count[GL_FTW_F] &&
+                          t.count[GL_FTW_SL] == host.count[GL_FTW_SL],
+              "nopenfd %d: %d dirs %d files %d links, host %d %d %d", limits[i],
+              t.count[GL_FTW_D], t.count[GL_FTW_F], t.count[GL_FTW_SL],
+              host.count[GL_FTW_D], host.count[GL_FTW_F], host.count[GL_FTW_SL]);
+        CHECK("ftw_walk", t.max_open - base_fds <= limits[i],
+              "nopenfd %d: %d descriptors open", limits[i], t.max_open - base_fds);
+    }
+
+    struct tally t = { { 0 } };
+    gl_ftw_walk(root, gl_visit, &t, 4, GL_FTW_DEPTH);
+    CHECK("ftw_walk", t.count[GL_FTW_DP] == host.count[GL_FTW_D] && t.count[GL_FTW_D] == 0,
+          "FTW_DEPTH: %d post-order dirs, %d pre-order", t.count[GL_FTW_DP], t.count[GL_FTW_D]);
+
+    struct tally stop = { { 0 }, 0, 3 };
+    CHECK("ftw_walk", gl_ftw_walk(root, gl_visit, &stop, 4, 0) == 42, "callback value not returned");
+
+    // Neither is followed or opened in a way that waits for a writer.
+    char path[512];
+    struct tally one = { { 0 } };
+    snprintf(path, sizeof(path), "%s/fifo", root);
+    gl_ftw_walk(path, gl_visit, &one, 4, 0);
+    CHECK("ftw_walk", one.count[GL_FTW_F] == 1, "FIFO as start path is not FTW_F");
+    struct tally link = { { 0 } };
+    snprintf(path, sizeof(path), "%s/link", root);
+    gl_ftw_walk(path, gl_visit, &link, 4, 0);
+    CHECK("ftw_walk", link.count[GL_FTW_NS] == 1 && link.count[GL_FTW_D] == 0,
+          "symlink as start path was followed");
+    struct tally none = { { 0 } };
+    snprintf(path, sizeof(path), "%s/missing", root);
+    gl_ftw_walk(path, gl_visit, &none, 4, 0);
+    CHECK("ftw_walk", none.count[GL_FTW_NS] == 1, "missing start path is not FTW_NS");
+}
+
+static void check_readdir(void) {
+    gl_DIR* d = gl_opendir(root);
+    CHECK("opendir", d != NULL, "%s", root);
+    if (!d) return;
+    int n = 0;
+    while (gl_readdir(d)) n++;
+    CHECK("readdir", n == 5 && d->error == 0, "%d entries, error %d", n, d->error);
+    gl_closedir(d);
+
+    // A descriptor that isn't a directory: the kernel read fails, which
+    // must not look like an empty listing.
+    snprintf(root + strlen(root), 8, "/d0/f");
+    d = gl_opendir(root);
+    root[strlen(root) - 5] = '\0';
+    CHECK("opendir", d != NULL, "plain file");
+    if (!d) return;
+    CHECK("readdir", gl_readdir(d) == NULL && d->error, "read of a plain file not reported");
+    gl_closedir(d);
+}
+
+void test_dirent(void) {
+    make_tree();
+    check_walk();
+    check_readdir();
+    nftw(root, remove_one, 64, FTW_PHYS | FTW_DEPTH);
+}
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * tests/test_hashmap.c
+ *
+ * The hash map against a plain array model under random puts, removes
+ * and lookups, and the environment functions built on it.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "harness.h"
+
+#define NKEYS   4096
+#define OPS     200000
+
+static char keys[NKEYS][16];
+static size_t key_len[NKEYS];
+static int present[NKEYS];
+
+// Counts what the map allocates through the hook, to catch leaks.
+static long live_bytes;
+
+static void* count_alloc(void* ctx, size_t size) {
+    *(long*)ctx += (long)size;
+    return malloc(size);
+}
+
+static void count_free(void* ctx, void* ptr, size_t size) {
+    *(long*)ctx -= (long)size;
+    free(ptr);
+}
+
+static void check_model(void) {
+    gl_hm_allocator alloc = { count_alloc, count_free, &live_bytes };
+    gl_hashmap m;
+    gl_hashmap_init(&m, &alloc);
+
+    // Keys share long prefixes and differ in length, so neither the
+    // hash nor the length alone tells them apart.
+    for (int i = 0; i < NKEYS; i++)
+        key_len[i] = (size_t)snprintf(keys[i], sizeof(keys[i]), "key%0*d", 1 + i % 9, i);
+    memset(present, 0, sizeof(present));
+
+    size_t size = 0;
+    for (int op = 0; op < OPS; op++) {
+        int k = (int)(rng() % NKEYS);
+        switch (rng() % 3) {
+            case 0:
+                CHECK("hashmap_put", gl_hashmap_put(&m, keys[k], key_len[k], (void*)(uintptr_t)(op + 1)) == 0,
+                      "put %s", keys[k]);
+                if (!present[k]) size++;
+                present[k] = op + 1;
+                break;
+            case 1: {
+                int r = gl_hashmap_remove(&m, keys[k], key_len[k]);
+                CHECK("hashmap_remove", (r == 0) == (present[k] != 0), "%s: returned %d, present %d",
+                      keys[k], r, present[k] != 0);
+                if (present[k]) size--;
+                present[k] = 0;
+                break;
+            }
+            default: {
+                void* v = gl_hashmap_get(&m, keys[k], key_len[k]);
+                CHECK("hashmap_get", v == (void*)(uintptr_t)present[k], "%s: %p, want %d",
+                      keys[k], v, present[k]);
+                break;
+            }
+        }
+    }
+    CHECK("hashmap", m.size == size, "size %zu, want %zu", m.size, size);
+
+    size_t iter = 0, seen = 0;
+    struct gl_hm_slot* s;
+    while ((s = gl_hashmap_next(&m, &iter))) {
+        int k = atoi((const char*)s->key + 3);
+        CHECK("hashmap_next", present[k] && s->value == (void*)(uintptr_t)present[k], "stale %.*s",
+              (int)s->len, (const char*)s->key);
+        seen++;
+    }
+    CHECK("hashmap_next", seen == size, "visited %zu of %zu", seen, size);
+
+    // A key that is a prefix of a stored one must not match it.
+    CHECK("hashmap_get", !gl_hashmap_get(&m, keys[1000], 4), "prefix matched");
+
+    gl_hashmap_clear(&m);
+    CHECK("hashmap_clear", m.size == 0 && !gl_hashmap_get(&m, keys[0], key_len[0]), "entries left");
+    CHECK("hashmap_reserve", gl_hashmap_reserve(&m, NKEYS) == 0, "reserve %d", NKEYS);
+    size_t cap = m.capacity;
+    for (int i = 0; i < NKEYS; i++)
+        gl_hashmap_put(&m, keys[i], key_len[i], NULL);
+    CHECK("hashmap_reserve", m.capacity == cap, "grew from %zu to %zu after reserve", cap, m.capacity);
+
+    gl_hashmap_destroy(&m);
+    CHECK("hashmap_destroy", live_bytes == 0, "%ld bytes not freed", live_bytes);
+}
+
+// The library keeps its own environ; point it at a test array.
+static char* initial[] = { "HOME=/root", "PATH=/bin", "HOME=/shadowed", "EMPTY=", NULL };
+
+static void check_env(void) {
+    gl_environ = initial;
+    CHECK("getenv", gl_getenv("HOME") && strcmp(gl_getenv("HOME"), "/root") == 0,
+          "first of two HOME entries should win");
+    CHECK("getenv", gl_getenv("EMPTY") && !*gl_getenv("EMPTY"), "empty value");
+    CHECK("getenv", !gl_getenv("PAT") && !gl_getenv("PATH=") && !gl_getenv(""), "bad names");
+
+    CHECK("setenv", gl_setenv("PATH", "/usr/bin", 0) == 0 && strcmp(gl_getenv("PATH"), "/bin") == 0,
+          "overwrite 0 replaced the value");
+    CHECK("setenv", gl_setenv("PATH", "/usr/bin", 1) == 0 && strcmp(gl_getenv("PATH"), "/usr/bin") == 0,
+          "overwrite 1 kept the old value");
+    CHECK("setenv", gl_setenv("A=B", "x", 1) != 0, "name with '=' accepted");
+    CHECK("environ", initial[1] && strcmp(initial[1], "PATH=/bin") == 0, "initial array modified");
+
+    // Unset removes every copy of a repeated name.
+    CHECK("unsetenv", gl_unsetenv("HOME") == 0 && !gl_getenv("HOME"), "HOME still set");
+    int homes = 0;
+    for (char** e = gl_environ; *e; e++)
+        if (strncmp(*e, "HOME=", 5) == 0) homes++;
+    CHECK("unsetenv", homes == 0, "%d HOME entries left in environ", homes);
+
+    // Many variables: indexed lookups must see every one.
+    char name[32], value[32];
+    for (int i = 0; i < 1000; i++) {
+        snprintf(name, sizeof(name), "VAR%d", i);
+        snprintf(value, sizeof(value), "%d", i * 7);
+        gl_setenv(name, value, 1);
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        snprintf(name, sizeof(name), "VAR%d", i);
+        gl_unsetenv(name);
+    }
+    int wrong = 0;
+    for (int i = 0; i < 1000; i++) {
+        snprintf(name, sizeof(name), "VAR%d", i);
+        const char* v = gl_getenv(name);
+        if (i % 2 == 0 ? v != NULL : !v || atoi(v) != i * 7) wrong++;
+    }
+    CHECK("setenv", wrong == 0, "%d of 1000 variables wrong", wrong);
+
+    static char put[] = "PUT=1";
+    CHECK("putenv", gl_putenv(put) == 0 && strcmp(gl_getenv("PUT"), "1") == 0, "not set");
+    put[4] = '2';
+    CHECK("putenv", strcmp(gl_getenv("PUT"), "2") == 0, "string was copied");
+
+    // A program that swaps environ out from under us gets fresh lookups.
+    static char* other[] = { "ONLY=here", NULL };
+    gl_environ = other;
+    CHECK("environ", gl_getenv("ONLY") && !gl_getenv("PATH"), "stale index after environ changed");
+}
+
+void test_hashmap(void) {
+    check_model();
+    check_env();
+}
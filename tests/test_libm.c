@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * tests/test_libm.c
+ * 
+ * libm against the host's, measured in units in the last place.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "harness.h"
+
+#define SAMPLES 200000
+
+#define POW_MAX_ULP     2250000000000ull
+#define FMOD_MAX_ULP    0
+
+static uint64_t ulp_distance(double a, double b) {
+    if (isnan(a) || isnan(b)) return isnan(a) && isnan(b) ? 0 : UINT64_MAX;
+    int64_t ia, ib;
+    memcpy(&ia, &a, 8);
+    memcpy(&ib, &b, 8);
+    if (ia < 0) ia = INT64_MIN - ia;
+    if (ib < 0) ib = INT64_MIN - ib;
+    return ia > ib ? (uint64_t)(ia - ib) : (uint64_t)(ib - ia);
+}
+
+static double uniform(double lo, double hi) {
+    return lo + (hi - lo) * ((double)(rng() >> 11) / 9007199254740992.0);
+}
+
+/*
+ * Error bounds per domain: twice the worst error measured over a dozen
+ * seeds (CHECK_VERBOSE=1 prints the measurements), so a change that
+ * makes any range noticeably worse fails. exp, log, pow and the trig
+ * functions are short polynomials; the bounds pin down what they do
+ * now rather than certify accuracy. The trig functions, and log around
+ * 1, are checked by absolute error because their results pass through
+ * zero, where ulp distance is meaningless. fmod is exact.
+ *
+ * sqrt is only checked on the sqrtsd path: the harness builds for the
+ * host, where SSE2 is always there, so the Newton-Raphson fallback that
+ * i386 builds use is never run here.
+ */
+struct unary_case {
+    const char* name;
+    double (*got)(double);
+    double (*want)(double);
+    double lo, hi;
+    uint64_t max_ulp;       // 0 = exact
+    double max_abs;         // used instead of ulps when nonzero
+};
+
+static const struct unary_case unary[] = {
+    { "fabs",  gl_fabs,  fabs,  -1e300, 1e300, 0, 0 },
+    { "floor", gl_floor, floor, -4e15,  4e15,  0, 0 },
+    { "floor", gl_floor, floor, -100,   100,   0, 0 },
+    { "ceil",  gl_ceil,  ceil,  -4e15,  4e15,  0, 0 },
+    { "ceil",  gl_ceil,  ceil,  -100,   100,   0, 0 },
+    { "sqrt",  gl_sqrt,  sqrt,  0,      1e300, 0, 0 },
+    { "sqrt",  gl_sqrt,  sqrt,  0,      4,     0, 0 },
+    { "exp",   gl_exp,   exp,   -700,   700,   90000000ull, 0 },
+    { "exp",   gl_exp,   exp,   -20,    20,    90000000ull, 0 },
+    { "exp",   gl_exp,   exp,   -1,     1,     90000000ull, 0 },
+    { "log",   gl_log,   log,   1e-300, 1e300, 220000000ull, 0 },
+    { "log",   gl_log,   log,   2,      1e6,   54000000000ull, 0 },
+    { "log",   gl_log,   log,   1e-6,   0.5,   224000000000ull, 0 },
+    { "log",   gl_log,   log,   0.5,    2,     0, 2.5e-5 },
+    { "sin",   gl_sin,   sin,   -1,     1,     0, 7.2e-6 },
+    { "sin",   gl_sin,   sin,   -100,   100,   0, 7.2e-6 },
+    { "sin",   gl_sin,   sin,   -1e4,   1e4,   0, 7.2e-6 },
+    { "cos",   gl_cos,   cos,   -1,     1,     0, 7.2e-6 },
+    { "cos",   gl_cos,   cos,   -100,   100,   0, 7.2e-6 },
+    { "cos",   gl_cos,   cos,   -1e4,   1e4,   0, 7.2e-6 },
+    { "tan",   gl_tan,   tan,   -1,     1,     0, 9.2e-6 },
+    { "tan",   gl_tan,   tan,   -1.4,   1.4,   0, 9.2e-6 },
+    { "tan",   gl_tan,   tan,   2,      4,     0, 9.2e-6 },
+};
+
+static void check_unary(const struct unary_case* c) {
+    uint64_t worst = 0;
+    double worst_abs = 0, worst_x = 0;
+    for (int i = 0; i < SAMPLES; i++) {
+        double x = uniform(c->lo, c->hi);
+        double g = c->got(x), w = c->want(x);
+        if (c->max_abs) {
+            double e = fabs(g - w);
+            if (e > worst_abs) { worst_abs = e; worst_x = x; }
+        } else {
+            uint64_t d = ulp_distance(g, w);
+            if (d > worst) { worst = d; worst_x = x; }
+        }
+    }
+    if (getenv("CHECK_VERBOSE"))
+        printf("  %-6s [%g, %g]: max %llu ulp, %.3g abs\n", c->name, c->lo, c->hi,
+               (unsigned long long)worst, worst_abs);
+    if (c->max_abs)
+        CHECK(c->name, worst_abs <= c->max_abs, "[%g, %g]: abs error %.3g at %.17g",
+              c->lo, c->hi, worst_abs, worst_x);
+    else
+        CHECK(c->name, worst <= c->max_ulp, "[%g, %g]: %llu ulp at %.17g",
+              c->lo, c->hi, (unsigned long long)worst, worst_x);
+}
+
+static void check_binary(void) {
+    uint64_t worst_pow = 0, worst_fmod = 0;
+    double px = 0, py = 0, fx = 0, fy = 0;
+    for (int i = 0; i < SAMPLES; i++) {
+        double x = uniform(1e-3, 100), y = uniform(-10, 10);
+        uint64_t d = ulp_distance(gl_pow(x, y), pow(x, y));
+        if (d > worst_pow) { worst_pow = d; px = x; py = y; }
+
+        x = uniform(-1e6, 1e6);
+        y = uniform(1e-3, 1e3);
+        d = ulp_distance(gl_fmod(x, y), fmod(x, y));
+        if (d > worst_fmod) { worst_fmod = d; fx = x; fy = y; }
+    }
+    if (getenv("CHECK_VERBOSE")) {
+        printf("  pow: max %llu ulp\n", (unsigned long long)worst_pow);
+        printf("  fmod: max %llu ulp\n", (unsigned long long)worst_fmod);
+    }
+    CHECK("pow", worst_pow <= POW_MAX_ULP, "%llu ulp at (%.17g, %.17g)",
+          (unsigned long long)worst_pow, px, py);
+    CHECK("fmod", worst_fmod <= FMOD_MAX_ULP, "%llu ulp at (%.17g, %.17g)",
+          (unsigned long long)worst_fmod, fx, fy);
+}
+
+// Special values the implementation documents
+static void check_special(void) {
+    CHECK("sqrt", isnan(gl_sqrt(-1.0)), "sqrt(-1) not NaN");
+    CHECK("sqrt", gl_sqrt(0.0) == 0.0, "sqrt(0)");
+    CHECK("fabs", !signbit(gl_fabs(-0.0)), "fabs(-0) keeps the sign");
+    CHECK("floor", gl_floor(-0.5) == -1.0 && gl_floor(2.0) == 2.0, "floor");
+    CHECK("ceil", gl_ceil(-0.5) == 0.0 && gl_ceil(2.5) == 3.0, "ceil");
+    CHECK("fmod", isnan(gl_fmod(1.0, 0.0)), "fmod(x, 0) not NaN");
+    CHECK("exp", isinf(gl_exp(1000.0)) && gl_exp(-1000.0) == 0.0, "exp overflow/underflow");
+    CHECK("exp", gl_exp(0.0) == 1.0, "exp(0)");
+    CHECK("log", isnan(gl_log(-1.0)), "log(-1) not NaN");
+    CHECK("log", gl_log(1.0) == 0.0, "log(1)");
+    CHECK("pow", gl_pow(0.0, 0.0) == 1.0 && gl_pow(0.0, 2.0) == 0.0, "pow(0, y)");
+    CHECK("pow", fabs(gl_pow(-2.0, 3.0) + 8.0) < 1e-9, "pow(-2, 3) = %g", gl_pow(-2.0, 3.0));
+    CHECK("pow", isnan(gl_pow(-2.0, 0.5)), "pow(-2, 0.5) not NaN");
+    CHECK("sin", gl_sin(0.0) == 0.0 && gl_cos(0.0) == 1.0, "sin/cos(0)");
+    CHECK("tan", gl_tan(0.0) == 0.0, "tan(0)");
+}
+
+void test_libm(void) {
+    for (size_t i = 0; i < sizeof(unary) / sizeof(unary[0]); i++)
+        check_unary(&unary[i]);
+    check_binary();
+    check_special();
+}
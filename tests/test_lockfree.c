@@ -0,0 +1,199 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * tests/test_lockfree.c
+ *
+ * The MPMC queue and Treiber stack under concurrent use, and the
+ * allocator's deferred free path that is built on the stack.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "harness.h"
+
+#define NTHREADS    4
+#define PER_THREAD  50000
+
+static gl_lf_queue queue;
+static volatile int producers_left;
+
+// Values are 1 + thread * PER_THREAD + i, so each appears exactly once.
+static void* producer(void* arg) {
+    uintptr_t base = 1 + (uintptr_t)arg * PER_THREAD;
+    for (uintptr_t i = 0; i < PER_THREAD; i++)
+        while (gl_lf_queue_push(&queue, (void*)(base + i)) != 0)
+            sched_yield();
+    __atomic_fetch_sub(&producers_left, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static unsigned char seen[NTHREADS * PER_THREAD + 1];
+
+static void* consumer(void* arg) {
+    long dups = 0;
+    void* v;
+    (void)arg;
+    for (;;) {
+        if (gl_lf_queue_pop(&queue, &v) == 0) {
+            if (__atomic_exchange_n(&seen[(uintptr_t)v], 1, __ATOMIC_RELAXED)) dups++;
+        } else if (__atomic_load_n(&producers_left, __ATOMIC_ACQUIRE) == 0) {
+            // Producers are done; whatever is left is visible now.
+            while (gl_lf_queue_pop(&queue, &v) == 0)
+                if (__atomic_exchange_n(&seen[(uintptr_t)v], 1, __ATOMIC_RELAXED)) dups++;
+            return (void*)dups;
+        } else {
+            sched_yield();
+        }
+    }
+}
+
+static void check_queue(void) {
+    void* v;
+    CHECK("lf_queue_init", gl_lf_queue_init(&queue, 3) != 0, "capacity 3 accepted");
+    CHECK("lf_queue_init", gl_lf_queue_init(&queue, 4) == 0, "capacity 4");
+    for (int i = 0; i < 4; i++)
+        gl_lf_queue_push(&queue, (void*)(uintptr_t)(i + 1));
+    CHECK("lf_queue_push", gl_lf_queue_push(&queue, (void*)9) != 0, "push to a full queue");
+    for (int i = 0; i < 4; i++)
+        CHECK("lf_queue_pop", gl_lf_queue_pop(&queue, &v) == 0 && v == (void*)(uintptr_t)(i + 1),
+              "FIFO order at %d", i);
+    CHECK("lf_queue_pop", gl_lf_queue_pop(&queue, &v) != 0, "pop from an empty queue");
+    gl_lf_queue_destroy(&queue);
+
+    gl_lf_queue_init(&queue, 256);
+    memset(seen, 0, sizeof(seen));
+    producers_left = NTHREADS / 2;
+    gl_pthread_t t[NTHREADS];
+    for (intptr_t i = 0; i < NTHREADS; i++)
+        gl_pthread_create(&t[i], NULL, i < NTHREADS / 2 ? producer : consumer, (void*)i);
+    long dups = 0;
+    for (int i = 0; i < NTHREADS; i++) {
+        void* r = NULL;
+        gl_pthread_join(t[i], &r);
+        if (i >= NTHREADS / 2) dups += (long)r;
+    }
+    long missing = 0;
+    for (size_t i = 1; i <= (size_t)(NTHREADS / 2) * PER_THREAD; i++)
+        if (!seen[i]) missing++;
+    CHECK("lf_queue", dups == 0 && missing == 0, "%ld duplicated, %ld lost", dups, missing);
+    gl_lf_queue_destroy(&queue);
+}
+
+static gl_lf_stack stack;
+static struct gl_lf_node nodes[NTHREADS][PER_THREAD / 10];
+
+// Each thread pushes its own nodes and pops as many as it pushed, so at
+// the end the stack is empty and every node was handed out once.
+static void* stack_worker(void* arg) {
+    struct gl_lf_node* mine = nodes[(intptr_t)arg];
+    long popped = 0;
+    for (int i = 0; i < PER_THREAD / 10; i++) {
+        gl_lf_stack_push(&stack, &mine[i]);
+        if (gl_lf_stack_pop(&stack)) popped++;
+    }
+    return (void*)popped;
+}
+
+static void check_stack(void) {
+    gl_pthread_t t[NTHREADS];
+    for (intptr_t i = 0; i < NTHREADS; i++)
+        gl_pthread_create(&t[i], NULL, stack_worker, (void*)i);
+    long popped = 0;
+    for (int i = 0; i < NTHREADS; i++) {
+        void* r;
+        gl_pthread_join(t[i], &r);
+        popped += (long)r;
+    }
+    CHECK("lf_stack", popped == NTHREADS * (PER_THREAD / 10) && !gl_lf_stack_pop(&stack),
+          "popped %ld of %d", popped, NTHREADS * (PER_THREAD / 10));
+    CHECK("lf_stack_empty", gl_lf_stack_empty(&stack), "empty stack with a nonzero tag");
+    gl_lf_stack_push(&stack, &nodes[0][0]);
+    CHECK("lf_stack_empty", !gl_lf_stack_empty(&stack), "one node");
+    gl_lf_stack_pop_all(&stack);
+}
+
+/*
+ * free() while another thread holds the heap lock parks the block on a
+ * stack linked through its payload. Holding the lock here forces that
+ * path: the block must stay out of the heap until the lock is dropped,
+ * a second free of it must be ignored (pushing it twice would loop the
+ * stack), and the next heap call must take it back.
+ */
+static void check_deferred_free(void) {
+    char* p = gl_malloc(40);
+    gl_pthread_mutex_lock(&gl_heap_lock);
+    gl_free(p);
+    gl_free(p);
+    gl_pthread_mutex_unlock(&gl_heap_lock);
+
+    char* a = gl_malloc(40);
+    char* b = gl_malloc(40);
+    CHECK("deferred free", a == p, "parked block not reused: got %p, freed %p",
+          (void*)a, (void*)p);
+    CHECK("deferred free", b != a, "block handed out twice after double free");
+    gl_free(a);
+    gl_free(b);
+    gl_free(b);  // already free: ignored
+    char* c = gl_malloc(40);
+    char* d = gl_malloc(40);
+    CHECK("double free", c != d, "block handed out twice after double free");
+    gl_free(c);
+    gl_free(d);
+}
+
+// Threads allocate, fill, verify and free, so frees often land while
+// another thread holds the lock. Any block handed out twice shows up as
+// a clobbered pattern. (Double frees can't be mixed in here: between
+// the two, another thread may legitimately get the block.)
+static void* heap_worker(void* arg) {
+    enum { SLOTS = 32 };
+    unsigned char* slot[SLOTS] = { 0 };
+    size_t len[SLOTS] = { 0 };
+    unsigned char tag = (unsigned char)(uintptr_t)arg + 1;
+    long bad = 0;
+    uint64_t x = 0x9E3779B97F4A7C15ull * tag;
+
+    for (int i = 0; i < PER_THREAD; i++) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        int s = (int)(x % SLOTS);
+        if (slot[s]) {
+            for (size_t j = 0; j < len[s]; j++)
+                if (slot[s][j] != tag) {
+                    bad++;
+                    break;
+                }
+            gl_free(slot[s]);
+        }
+        len[s] = 8 + (size_t)(x >> 20) % 200;
+        slot[s] = gl_malloc(len[s]);
+        memset(slot[s], tag, len[s]);
+    }
+    for (int s = 0; s < SLOTS; s++) gl_free(slot[s]);
+    return (void*)bad;
+}
+
+static void check_heap_threads(void) {
+    gl_pthread_t t[NTHREADS];
+    for (intptr_t i = 0; i < NTHREADS; i++)
+        gl_pthread_create(&t[i], NULL, heap_worker, (void*)i);
+    long bad = 0;
+    for (int i = 0; i < NTHREADS; i++) {
+        void* r;
+        gl_pthread_join(t[i], &r);
+        bad += (long)r;
+    }
+    CHECK("threaded malloc", bad == 0, "%ld blocks clobbered by another thread", bad);
+}
+
+void test_lockfree(void) {
+    check_queue();
+    check_stack();
+    check_deferred_free();
+    check_heap_threads();
+}
@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * tests/test_malloc.c
+ *
+ * Allocator correctness: alignment, splitting and coalescing, realloc
+ * and calloc edge cases, and a random workload that checks every live
+ * block for clobbering.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "harness.h"
+
+#define SLOTS   256
+#define OPS     100000
+
+// Sizes here are far above anything else the suite allocates, so the
+// blocks involved are the only ones in their bins.
+#define BIG     (3 << 20)
+#define PART    (1 << 20)
+
+static void check_split_coalesce(void) {
+    char* p = gl_malloc(BIG);
+    char* guard = gl_malloc(64);  // keeps p's block from merging into the top
+    CHECK("malloc", p && guard, "out of memory");
+    if (!p || !guard) return;
+    gl_free(p);
+
+    // Both halves come out of the freed block...
+    char* a = gl_malloc(PART);
+    char* b = gl_malloc(PART);
+    CHECK("malloc split", a == p, "first part at %p, freed block at %p", (void*)a, (void*)p);
+    CHECK("malloc split", b > a && b < p + BIG, "second part at %p, outside the freed block", (void*)b);
+
+    // ...and freeing them merges everything back into one block that
+    // holds the original size again.
+    gl_free(b);
+    gl_free(a);
+    char* c = gl_malloc(BIG);
+    CHECK("free coalesce", c == p, "got %p, want the merged block at %p", (void*)c, (void*)p);
+    gl_free(c);
+    gl_free(guard);
+}
+
+static void check_realloc_calloc(void) {
+    char* p = gl_realloc(NULL, 100);
+    CHECK("realloc", p != NULL, "realloc(NULL) did not allocate");
+    for (int i = 0; i < 100; i++) p[i] = (char)i;
+    CHECK("realloc", gl_realloc(p, 50) == p, "shrinking moved the block");
+    char* q = gl_realloc(p, 100000);
+    int same = q != NULL;
+    for (int i = 0; same && i < 100; i++) same = q[i] == (char)i;
+    CHECK("realloc", same, "contents lost when growing");
+    CHECK("realloc", gl_realloc(q, 0) == NULL, "realloc(p, 0) returned a block");
+
+    CHECK("calloc", gl_calloc(SIZE_MAX / 2 + 1, 2) == NULL, "nmemb * size overflow accepted");
+    CHECK("calloc", gl_calloc(2, SIZE_MAX / 2 + 1) == NULL, "nmemb * size overflow accepted");
+    CHECK("malloc", gl_malloc(SIZE_MAX - 8) == NULL, "huge request succeeded");
+
+    // Reused memory is dirty; calloc must still hand it out zeroed.
+    p = gl_malloc(4096);
+    memset(p, 0xAA, 4096);
+    gl_free(p);
+    q = gl_calloc(64, 64);
+    int zero = q != NULL;
+    for (int i = 0; zero && i < 4096; i++) zero = q[i] == 0;
+    CHECK("calloc", zero, "memory not zeroed");
+    gl_free(q);
+}
+
+static void check_random(void) {
+    static unsigned char* slot[SLOTS];
+    static size_t len[SLOTS];
+    long bad = 0, misaligned = 0;
+
+    for (int op = 0; op < OPS; op++) {
+        int s = (int)(rng() % SLOTS);
+        unsigned char tag = (unsigned char)(s + 1);
+        if (slot[s]) {
+            for (size_t j = 0; j < len[s]; j++)
+                if (slot[s][j] != tag) {
+                    bad++;
+                    break;
+                }
+        }
+        size_t n = rng() % 8 == 0 ? rng() % 65536 : rng() % 512;
+        if (slot[s] && rng() % 2) {
+            // realloc keeps the common prefix; refill the rest.
+            unsigned char* r = gl_realloc(slot[s], n);
+            if (n && !r) continue;
+            slot[s] = r;
+        } else {
+            gl_free(slot[s]);
+            slot[s] = gl_malloc(n);
+        }
+        len[s] = slot[s] ? n : 0;
+        if ((uintptr_t)slot[s] % 16) misaligned++;
+        if (slot[s]) memset(slot[s], tag, n);
+    }
+    for (int s = 0; s < SLOTS; s++) {
+        gl_free(slot[s]);
+        slot[s] = NULL;
+    }
+    CHECK("malloc", bad == 0, "%ld blocks clobbered", bad);
+    CHECK("malloc", misaligned == 0, "%ld blocks not 16-byte aligned", misaligned);
+}
+
+void test_malloc(void) {
+    check_split_coalesce();
+    check_realloc_calloc();
+    check_random();
+}
@@ -0,0 +1,234 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * tests/test_sort.c
+ *
+ * qsort, bsearch, the radix sorts, and the task pool's parallel_for and
+ * parallel_qsort, checked against the host's qsort.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "harness.h"
+
+#define N (1 << 18)
+
+static int cmp_u32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+// 12 bytes: no specialized swap, so the generic one gets exercised.
+struct rec {
+    uint32_t key, a, b;
+};
+
+static int cmp_rec(const void* a, const void* b) {
+    return cmp_u32(&((const struct rec*)a)->key, &((const struct rec*)b)->key);
+}
+
+static int cmp_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+// 16 bytes: the widest specialized swap.
+struct pair {
+    uint64_t key, check;
+};
+
+static int cmp_pair(const void* a, const void* b) {
+    return cmp_u64(&((const struct pair*)a)->key, &((const struct pair*)b)->key);
+}
+
+// Keys of a given shape, so the partition's worst cases come up.
+static uint64_t key_at(int shape, size_t i, size_t n) {
+    switch (shape) {
+        case 0:  return rng();
+        case 1:  return i;              // sorted
+        case 2:  return n - i;          // reversed
+        case 3:  return rng() % 4;      // few distinct
+        default: return i % 2 ? i : n - i;  // organ pipe
+    }
+}
+
+static size_t rand_n(void) {
+    return rng() % 4 == 0 ? rng() % 20000 : rng() % 100;
+}
+
+static void check_qsort(void) {
+    for (int it = 0; it < 200; it++) {
+        size_t n = rand_n();
+        int shape = (int)(rng() % 5);
+        uint32_t* got32 = malloc((n + 1) * sizeof(uint32_t));
+        uint32_t* want32 = malloc((n + 1) * sizeof(uint32_t));
+        uint64_t* got64 = malloc((n + 1) * sizeof(uint64_t));
+        uint64_t* want64 = malloc((n + 1) * sizeof(uint64_t));
+        struct pair* pairs = malloc((n + 1) * sizeof(struct pair));
+        struct rec* recs = malloc((n + 1) * sizeof(struct rec));
+        for (size_t i = 0; i < n; i++) {
+            got64[i] = want64[i] = key_at(shape, i, n);
+            got32[i] = want32[i] = (uint32_t)got64[i];
+            pairs[i].key = got64[i];
+            pairs[i].check = ~got64[i];
+            recs[i].key = got32[i];
+            recs[i].a = got32[i] ^ 0x5555;
+            recs[i].b = ~got32[i];
+        }
+
+        gl_qsort(got32, n, sizeof(uint32_t), cmp_u32);
+        qsort(want32, n, sizeof(uint32_t), cmp_u32);
+        CHECK("qsort", memcmp(got32, want32, n * sizeof(uint32_t)) == 0, "u32, n %zu shape %d", n, shape);
+        gl_qsort(got64, n, sizeof(uint64_t), cmp_u64);
+        qsort(want64, n, sizeof(uint64_t), cmp_u64);
+        CHECK("qsort", memcmp(got64, want64, n * sizeof(uint64_t)) == 0, "u64, n %zu shape %d", n, shape);
+
+        gl_qsort(pairs, n, sizeof(struct pair), cmp_pair);
+        gl_qsort(recs, n, sizeof(struct rec), cmp_rec);
+        size_t bad = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (pairs[i].key != want64[i] || pairs[i].check != ~want64[i]) bad++;
+            if (recs[i].key != want32[i] || recs[i].a != (want32[i] ^ 0x5555)) bad++;
+        }
+        CHECK("qsort", bad == 0, "16/12-byte records, n %zu shape %d: %zu wrong", n, shape, bad);
+
+        // Every key is found; one past the largest is not.
+        bad = 0;
+        for (size_t i = 0; i < n; i++) {
+            uint64_t* hit = gl_bsearch(&want64[i], want64, n, sizeof(uint64_t), cmp_u64);
+            if (!hit || *hit != want64[i]) bad++;
+        }
+        CHECK("bsearch", bad == 0, "n %zu: %zu keys not found", n, bad);
+        if (!n || want64[n - 1] != UINT64_MAX) {
+            uint64_t missing = n ? want64[n - 1] + 1 : 0;
+            CHECK("bsearch", !gl_bsearch(&missing, want64, n, sizeof(uint64_t), cmp_u64),
+                  "n %zu: found a key that isn't there", n);
+        }
+
+        free(got32);
+        free(want32);
+        free(got64);
+        free(want64);
+        free(pairs);
+        free(recs);
+    }
+}
+
+static void check_radix(void) {
+    for (int it = 0; it < 100; it++) {
+        size_t n = rand_n();
+        int shape = (int)(rng() % 5);
+        uint32_t* k32 = malloc((n + 1) * sizeof(uint32_t));
+        uint32_t* w32 = malloc((n + 1) * sizeof(uint32_t));
+        uint64_t* k64 = malloc((n + 1) * sizeof(uint64_t));
+        uint64_t* w64 = malloc((n + 1) * sizeof(uint64_t));
+        for (size_t i = 0; i < n; i++) {
+            k64[i] = w64[i] = key_at(shape, i, n) * 0x9E3779B97F4A7C15ull;
+            k32[i] = w32[i] = (uint32_t)(k64[i] >> 32);
+        }
+        CHECK("radix_sort_u32", gl_radix_sort_u32(k32, n) == 0, "n %zu: failed", n);
+        qsort(w32, n, sizeof(uint32_t), cmp_u32);
+        CHECK("radix_sort_u32", memcmp(k32, w32, n * sizeof(uint32_t)) == 0, "n %zu shape %d", n, shape);
+        CHECK("radix_sort_u64", gl_radix_sort_u64(k64, n) == 0, "n %zu: failed", n);
+        qsort(w64, n, sizeof(uint64_t), cmp_u64);
+        CHECK("radix_sort_u64", memcmp(k64, w64, n * sizeof(uint64_t)) == 0, "n %zu shape %d", n, shape);
+        free(k32);
+        free(w32);
+        free(k64);
+        free(w64);
+    }
+}
+
+static void check_pool_size(void) {
+    // nworkers 0 means one per CPU
+    gl_task_pool_init(0);
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    CHECK("task_pool_init", gl_task_pool_size() == cpus, "%d workers for %ld CPUs",
+          gl_task_pool_size(), cpus);
+    gl_task_pool_shutdown();
+
+    // Several workers even on a small machine, so stealing happens
+    gl_task_pool_init(4);
+    CHECK("task_pool_init", gl_task_pool_size() == 4, "%d workers, want 4",
+          gl_task_pool_size());
+}
+
+static unsigned char touched[N];
+
+static void touch(size_t begin, size_t end, void* ctx) {
+    (void)ctx;
+    for (size_t i = begin; i < end; i++)
+        __atomic_fetch_add(&touched[i], 1, __ATOMIC_RELAXED);
+}
+
+static void check_parallel_for(void) {
+    memset(touched, 0, sizeof(touched));
+    gl_parallel_for(0, N, 1000, touch, NULL);
+    size_t wrong = 0;
+    for (size_t i = 0; i < N; i++)
+        if (touched[i] != 1) wrong++;
+    CHECK("parallel_for", wrong == 0, "%zu indices not visited exactly once", wrong);
+}
+
+// Chunks that sleep keep the rest of the group busy long enough for the
+// waiting thread to give up spinning and park; it must still come back.
+static void touch_slowly(size_t begin, size_t end, void* ctx) {
+    (void)ctx;
+    usleep(2000);
+    touch(begin, end, NULL);
+}
+
+static void check_parallel_for_wait(void) {
+    memset(touched, 0, 64);
+    gl_parallel_for(0, 64, 4, touch_slowly, NULL);
+    size_t wrong = 0;
+    for (size_t i = 0; i < 64; i++)
+        if (touched[i] != 1) wrong++;
+    CHECK("task_wait", wrong == 0, "%zu indices not visited exactly once", wrong);
+}
+
+static void check_parallel_qsort(void) {
+    uint32_t* got = malloc(N * sizeof(uint32_t));
+    uint32_t* want = malloc(N * sizeof(uint32_t));
+
+    // Random keys, then heavy duplicates
+    for (int pass = 0; pass < 2; pass++) {
+        for (size_t i = 0; i < N; i++)
+            want[i] = pass ? (uint32_t)(rng() % 16) : (uint32_t)rng();
+        memcpy(got, want, N * sizeof(uint32_t));
+        gl_parallel_qsort(got, N, sizeof(uint32_t), cmp_u32);
+        qsort(want, N, sizeof(uint32_t), cmp_u32);
+        CHECK("parallel_qsort", memcmp(got, want, N * sizeof(uint32_t)) == 0,
+              "u32 keys differ from host qsort (pass %d)", pass);
+    }
+    free(got);
+    free(want);
+
+    struct rec* r = malloc(N * sizeof(struct rec));
+    for (size_t i = 0; i < N; i++) {
+        r[i].key = (uint32_t)rng();
+        r[i].a = r[i].key ^ 0x5555;
+        r[i].b = ~r[i].key;
+    }
+    gl_parallel_qsort(r, N, sizeof(struct rec), cmp_rec);
+    size_t bad = 0;
+    for (size_t i = 0; i < N; i++) {
+        if (i && r[i - 1].key > r[i].key) bad++;
+        if (r[i].a != (r[i].key ^ 0x5555) || r[i].b != ~r[i].key) bad++;
+    }
+    CHECK("parallel_qsort", bad == 0, "12-byte records: %zu out of order or torn", bad);
+    free(r);
+}
+
+void test_sort(void) {
+    check_qsort();
+    check_radix();
+    check_pool_size();
+    check_parallel_for();
+    check_parallel_for_wait();
+    check_parallel_qsort();
+    gl_task_pool_shutdown();
+}
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * tests/test_spawn.c
+ *
+ * posix_spawn's file actions, seen from a /bin/sh child that reports
+ * on its descriptors through its exit status, and the parent's table
+ * afterwards: every target back as it was, close-on-exec flags too.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include "harness.h"
+
+// Targets, clear of anything the harness has open.
+#define FD_DUP      20  // a close-on-exec pipe end, replaced by dup2
+#define FD_OPEN     21  // closed; opened for the child only
+#define FD_CLOSE    22  // open without close-on-exec; closed for the child
+#define FD_SAVED    23  // where the saved copies start
+
+// Exits 11-14 for the check that failed, 0 if the child saw what it
+// should. sh can't redirect to descriptors above 9 by number, so the
+// write goes through /proc.
+static char script[] =
+    "echo dup >/proc/self/fd/20 || exit 11; "
+    "test -e /proc/self/fd/21 || exit 12; "
+    "test -e /proc/self/fd/22 && exit 13; "
+    "test -e /proc/self/fd/23 && exit 14; "
+    "echo out; exit 0";
+
+struct fd_state {
+    int flags;      // F_GETFD, or -1 if closed
+    dev_t dev;
+    ino_t ino;
+};
+
+static struct fd_state fd_state(int fd) {
+    struct fd_state s = { fcntl(fd, F_GETFD), 0, 0 };
+    struct stat st;
+    if (s.flags >= 0 && fstat(fd, &st) == 0) {
+        s.dev = st.st_dev;
+        s.ino = st.st_ino;
+    }
+    return s;
+}
+
+static int same_state(struct fd_state a, struct fd_state b) {
+    return a.flags == b.flags && a.dev == b.dev && a.ino == b.ino;
+}
+
+static void check_file_actions(void) {
+    int out[2], other[2];
+    if (pipe2(out, O_CLOEXEC) != 0 || pipe2(other, O_CLOEXEC) != 0) return;
+    dup3(other[1], FD_DUP, O_CLOEXEC);
+    close(FD_OPEN);
+    dup2(other[0], FD_CLOSE);
+    close(FD_SAVED);
+
+    int fds[] = { 1, FD_DUP, FD_OPEN, FD_CLOSE, FD_SAVED };
+    struct fd_state before[5];
+    for (int i = 0; i < 5; i++) before[i] = fd_state(fds[i]);
+
+    gl_posix_spawn_file_actions_t fa;
+    gl_posix_spawn_file_actions_init(&fa);
+    gl_posix_spawn_file_actions_adddup2(&fa, out[1], 1);
+    gl_posix_spawn_file_actions_adddup2(&fa, out[1], FD_DUP);
+    gl_posix_spawn_file_actions_addopen(&fa, FD_OPEN, "/dev/null", GL_O_RDONLY, 0);
+    gl_posix_spawn_file_actions_addclose(&fa, FD_CLOSE);
+
+    char* argv[] = { "sh", "-c", script, NULL };
+    int pid = 0, status = -1;
+    int err = gl_posix_spawn(&pid, "/bin/sh", &fa, NULL, argv, NULL);
+    CHECK("posix_spawn", err == 0 && pid > 0, "returned %d, pid %d", err, pid);
+
+    // The parent's table is back before the child is even reaped.
+    for (int i = 0; i < 5; i++) {
+        struct fd_state now = fd_state(fds[i]);
+        CHECK("posix_spawn", same_state(now, before[i]),
+              "fd %d: flags %d, want %d, or a different file", fds[i], now.flags, before[i].flags);
+    }
+
+    if (err == 0) {
+        CHECK("waitpid", gl_waitpid(pid, &status, 0) == pid, "pid %d not reaped", pid);
+        CHECK("posix_spawn", WIFEXITED(status) && WEXITSTATUS(status) == 0,
+              "child status %#x", status);
+    }
+
+    // Every write end is closed now, so this reads to EOF.
+    close(out[1]);
+    char buf[64];
+    ssize_t n, len = 0;
+    while ((n = read(out[0], buf + len, sizeof(buf) - 1 - len)) > 0) len += n;
+    buf[len] = '\0';
+    CHECK("posix_spawn", strcmp(buf, "dup\nout\n") == 0, "child wrote \"%s\"", buf);
+
+    // A spawn that fails leaves the table as it was, too.
+    err = gl_posix_spawn(&pid, "/nonexistent", &fa, NULL, argv, NULL);
+    CHECK("posix_spawn", err != 0, "missing program spawned");
+    for (int i = 1; i < 5; i++) {
+        struct fd_state now = fd_state(fds[i]);
+        CHECK("posix_spawn", same_state(now, before[i]), "fd %d changed by a failed spawn", fds[i]);
+    }
+
+    gl_posix_spawn_file_actions_destroy(&fa);
+    close(out[0]);
+    close(other[0]);
+    close(other[1]);
+    close(FD_DUP);
+    close(FD_CLOSE);
+}
+
+void test_spawn(void) {
+    check_file_actions();
+}
@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * tests/test_stdio.c
+ * 
+ * printf family against the host, for the conversions the library
+ * implements: %d %x %s %c and %%.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "harness.h"
+
+#define ITERS 20000
+
+static const int edge_ints[] = { 0, 1, -1, 9, 10, -10, 15, 16, 255, 256, 4096,
+                                 INT_MAX, INT_MIN, INT_MAX - 1, INT_MIN + 1 };
+
+static int rand_int(void) {
+    switch (rng() % 4) {
+        case 0:  return edge_ints[rng() % (sizeof(edge_ints) / sizeof(edge_ints[0]))];
+        case 1:  return (int)(rng() % 2000) - 1000;
+        default: return (int)rng();
+    }
+}
+
+// A format with up to three conversions of one type, in literal text.
+static void rand_format(char* fmt, char conv) {
+    static const char* const text[] = { "", "x", "value: ", " ", "[", "]", "%%", "a%%b" };
+    char* p = fmt;
+    int n = 1 + rng() % 3;
+    for (int i = 0; i < n; i++) {
+        p += sprintf(p, "%s%%%c", text[rng() % 8], conv);
+    }
+    sprintf(p, "%s", text[rng() % 8]);
+}
+
+static void compare(const char* fmt, const char* want, int want_len, const char* got, int got_len) {
+    CHECK("vsnprintf", got_len == want_len, "\"%s\": length %d, want %d", fmt, got_len, want_len);
+    CHECK("vsnprintf", strcmp(got, want) == 0, "\"%s\": \"%s\", want \"%s\"", fmt, got, want);
+}
+
+static int gl_format(char* buf, size_t size, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    int r = gl_vsnprintf(buf, size, fmt, args);
+    va_end(args);
+    return r;
+}
+
+static void test_conversions(void) {
+    char fmt[128], want[512], got[512];
+    static const char convs[] = "dxsc";
+
+    for (int it = 0; it < ITERS; it++) {
+        char conv = convs[it % 4];
+        rand_format(fmt, conv);
+        int wn, gn;
+
+        if (conv == 's') {
+            char s1[40], s2[40], s3[40];
+            size_t n = rng() % 39;
+            for (size_t i = 0; i < n; i++) s1[i] = (char)(' ' + rng() % 95);
+            s1[n] = '\0';
+            strcpy(s2, rng() % 2 ? "" : "hello");
+            strcpy(s3, "%d");
+            wn = snprintf(want, sizeof(want), fmt, s1, s2, s3);
+            gn = gl_format(got, sizeof(got), fmt, s1, s2, s3);
+        } else if (conv == 'c') {
+            int c1 = ' ' + rng() % 95, c2 = ' ' + rng() % 95, c3 = '%';
+            wn = snprintf(want, sizeof(want), fmt, c1, c2, c3);
+            gn = gl_format(got, sizeof(got), fmt, c1, c2, c3);
+        } else {
+            int a = rand_int(), b = rand_int(), c = rand_int();
+            wn = snprintf(want, sizeof(want), fmt, a, b, c);
+            gn = gl_format(got, sizeof(got), fmt, a, b, c);
+        }
+        compare(fmt, want, wn, got, gn);
+    }
+}
+
+static void test_truncation(void) {
+    char want[64], got[64];
+    for (int it = 0; it < ITERS / 4; it++) {
+        int v = rand_int();
+        size_t size = rng() % 40;
+        memset(want, '#', sizeof(want));
+        memset(got, '#', sizeof(got));
+        int wn = snprintf(want, size, "n=%d s=%s", v, "abcdef");
+        int gn = gl_format(got, size, "n=%d s=%s", v, "abcdef");
+        CHECK("truncation", wn == gn, "size %zu: %d vs %d", size, gn, wn);
+        CHECK("truncation", memcmp(want, got, sizeof(want)) == 0, "size %zu value %d", size, v);
+    }
+}
+
+static void test_wrappers(void) {
+    char want[128], got[128];
+    int v = rand_int();
+    snprintf(want, sizeof(want), "%s=%d (%x) %c%%", "key", v, v, 'z');
+
+    gl_sprintf(got, "%s=%d (%x) %c%%", "key", v, v, 'z');
+    CHECK("sprintf", strcmp(got, want) == 0, "\"%s\" vs \"%s\"", got, want);
+
+    char* s = NULL;
+    int n = gl_asprintf(&s, "%s=%d (%x) %c%%", "key", v, v, 'z');
+    CHECK("asprintf", s && n == (int)strlen(want) && strcmp(s, want) == 0, "\"%s\"", s ? s : "(null)");
+    gl_free(s);
+
+    // Longer than any fixed buffer in the formatter.
+    char big[3000], head[128];
+    memset(big, 'q', sizeof(big) - 1);
+    big[sizeof(big) - 1] = '\0';
+    snprintf(head, sizeof(head), "[%.100s", big);
+    n = gl_asprintf(&s, "[%s]%d", big, 7);
+    CHECK("asprintf", s && n == (int)sizeof(big) + 2 && strncmp(s, head, 101) == 0 &&
+                      strcmp(s + n - 3, "q]7") == 0, "%d bytes", n);
+    gl_free(s);
+
+    // Library-specific: snprintf returns the number of characters stored,
+    // not the untruncated length (vsnprintf returns the latter).
+    n = gl_snprintf(got, 5, "%d", 123456);
+    CHECK("snprintf", n == 4 && strcmp(got, "1234") == 0, "returned %d \"%s\"", n, got);
+
+    shim_capture_begin();
+    n = gl_printf("%s=%d (%x) %c%%", "key", v, v, 'z');
+    const char* out = shim_capture_end();
+    CHECK("printf", strcmp(out, want) == 0, "\"%s\" vs \"%s\"", out, want);
+    CHECK("printf", n == (int)strlen(want), "returned %d, want %d", n, (int)strlen(want));
+}
+
+void test_stdio(void) {
+    test_conversions();
+    test_truncation();
+    test_wrappers();
+}
@@ -0,0 +1,263 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * tests/test_string.c
+ * 
+ * string.h against the host: random lengths and alignments, plus
+ * strings that end right before an unmapped page.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "harness.h"
+
+#define ITERS   20000
+#define BUF     (8192 + 64)
+
+static unsigned char src[BUF], dst_a[BUF], dst_b[BUF];
+
+static size_t rand_len(void) {
+    // Mostly short, sometimes a few pages
+    switch (rng() % 8) {
+        case 0:  return rng() % 8192;
+        case 1:  return rng() % 16;
+        default: return rng() % 300;
+    }
+}
+
+static void fill(unsigned char* p, size_t n) {
+    for (size_t i = 0; i < n; i++) p[i] = (unsigned char)rng();
+}
+
+// A NUL-terminated random string of length n at p, bytes drawn from an
+// alphabet of the given size so that sets and repeats actually occur.
+static void rand_str(char* p, size_t n, int alphabet) {
+    for (size_t i = 0; i < n; i++) p[i] = (char)('a' + rng() % alphabet);
+    p[n] = '\0';
+}
+
+static void test_mem(void) {
+    for (int it = 0; it < ITERS; it++) {
+        size_t len = rand_len(), so = rng() % 32, dof = rng() % 32;
+        fill(src, BUF);
+        fill(dst_a, BUF);
+        memcpy(dst_b, dst_a, BUF);
+
+        void* r = gl_memcpy(dst_a + dof, src + so, len);
+        memcpy(dst_b + dof, src + so, len);
+        CHECK("memcpy", r == dst_a + dof, "wrong return");
+        CHECK("memcpy", memcmp(dst_a, dst_b, BUF) == 0, "len %zu src+%zu dst+%zu", len, so, dof);
+
+        int v = (int)rng();
+        r = gl_memset(dst_a + dof, v, len);
+        memset(dst_b + dof, v, len);
+        CHECK("memset", r == dst_a + dof, "wrong return");
+        CHECK("memset", memcmp(dst_a, dst_b, BUF) == 0, "len %zu dst+%zu value %d", len, dof, v);
+
+        // Equal up to a random point, then maybe one differing byte
+        memcpy(dst_a, src, BUF);
+        if (len && rng() % 2) dst_a[so + rng() % len] ^= (unsigned char)(1 + rng() % 255);
+        int got = gl_memcmp(dst_a + so, src + so, len);
+        int want = memcmp(dst_a + so, src + so, len);
+        CHECK("memcmp", sign(got) == sign(want), "len %zu: %d vs %d", len, got, want);
+    }
+}
+
+static void test_str(void) {
+    static char a[BUF], b[BUF], set[32];
+
+    for (int it = 0; it < ITERS; it++) {
+        size_t len = rand_len(), off = rng() % 32;
+        char* s = a + off;
+        rand_str(s, len, 1 + rng() % 26);
+
+        CHECK("strlen", gl_strlen(s) == len, "len %zu off %zu: got %zu", len, off, gl_strlen(s));
+        size_t max = rng() % (len + 8);
+        CHECK("strnlen", gl_strnlen(s, max) == strnlen(s, max), "len %zu max %zu", len, max);
+
+        int c = rng() % 4 ? 'a' + (int)(rng() % 28) : (int)(rng() % 512) - 256;
+        CHECK("strchr", gl_strchr(s, c) == strchr(s, c), "len %zu c %d", len, c);
+        CHECK("strchr", gl_strchr(s, 0) == s + len, "NUL not found");
+
+        rand_str(set, rng() % 6, 26);
+        CHECK("strpbrk", gl_strpbrk(s, set) == strpbrk(s, set), "set \"%s\"", set);
+        size_t want = strspn(s, set);
+        CHECK("strspn", want > 32767 || (size_t)gl_strspn(s, set) == want, "set \"%s\"", set);
+        want = strcspn(s, set);
+        CHECK("strcspn", want > 32767 || (size_t)gl_strcspn(s, set) == want, "set \"%s\"", set);
+
+        // strcmp: same prefix, then a random tail (possibly high bytes)
+        memcpy(b, s, len + 1);
+        if (len && rng() % 2) {
+            size_t at = rng() % len;
+            b[at] = (char)(rng() % 255 + 1);
+            b[at + 1 + rng() % (len - at)] = '\0';
+        }
+        CHECK("strcmp", sign(gl_strcmp(s, b)) == sign(strcmp(s, b)), "len %zu", len);
+
+        // Copies land in identically pre-filled buffers
+        fill(dst_a, BUF);
+        memcpy(dst_b, dst_a, BUF);
+        size_t d = rng() % 32;
+        char* pa = (char*)dst_a + d;
+        char* pb = (char*)dst_b + d;
+        size_t n = rng() % (len + 16);
+        switch (it % 5) {
+            case 0:
+                CHECK("strcpy", gl_strcpy(pa, s) == pa, "wrong return");
+                strcpy(pb, s);
+                break;
+            case 1:
+                CHECK("stpcpy", gl_stpcpy(pa, s) == pa + len, "wrong return");
+                stpcpy(pb, s);
+                break;
+            case 2:
+                CHECK("strncpy", gl_strncpy(pa, s, n) == pa, "wrong return");
+                strncpy(pb, s, n);
+                break;
+            case 3:
+                pa[0] = pb[0] = '\0';
+                if (len < 4000) {
+                    memcpy(pa, "head", 5);
+                    memcpy(pb, "head", 5);
+                }
+                CHECK("strcat", gl_strcat(pa, s) == pa, "wrong return");
+                strcat(pb, s);
+                break;
+            case 4: {
+                // Reference: copy at most n-1 bytes, NUL if n > 0, return strlen(src)
+                size_t r = gl_strlcpy(pa, s, n);
+                CHECK("strlcpy", r == len, "returned %zu, want %zu", r, len);
+                if (n) {
+                    size_t k = len < n - 1 ? len : n - 1;
+                    memcpy(pb, s, k);
+                    pb[k] = '\0';
+                }
+                break;
+            }
+        }
+        CHECK("strcpy family", memcmp(dst_a, dst_b, BUF) == 0, "case %d len %zu n %zu", it % 5, len, n);
+
+        char* dup = gl_strdup(s);
+        CHECK("strdup", dup && strcmp(dup, s) == 0, "len %zu", len);
+        gl_free(dup);
+        dup = gl_strndup(s, n);
+        CHECK("strndup", dup && strlen(dup) == (len < n ? len : n) && strncmp(dup, s, n) == 0,
+              "len %zu n %zu", len, n);
+        gl_free(dup);
+    }
+}
+
+static void test_strtok(void) {
+    static char a[1024], b[1024];
+    for (int it = 0; it < ITERS / 10; it++) {
+        size_t len = rng() % 200;
+        for (size_t i = 0; i < len; i++) a[i] = "ab ,;"[rng() % 5];
+        a[len] = '\0';
+        memcpy(b, a, len + 1);
+        const char* delim = rng() % 2 ? " " : " ,;";
+
+        char *sa, *sb;
+        char* ta = gl_strtok_r(a, delim, &sa);
+        char* tb = strtok_r(b, delim, &sb);
+        int tok = 0;
+        for (;;) {
+            CHECK("strtok_r", (ta == NULL) == (tb == NULL), "token %d", tok);
+            if (!ta || !tb) break;
+            CHECK("strtok_r", ta - a == tb - b && strcmp(ta, tb) == 0, "token %d", tok);
+            ta = gl_strtok_r(NULL, delim, &sa);
+            tb = strtok_r(NULL, delim, &sb);
+            tok++;
+        }
+    }
+}
+
+// Builds the same text in a strbuf and a plain array, across the switch
+// from the inline buffer to the heap.
+static void test_strbuf(void) {
+    static char want[BUF];
+    gl_strbuf sb;
+    gl_sb_init(&sb);
+
+    for (int round = 0; round < 2; round++) {
+        size_t len = 0;
+        while (len < 4000) {
+            char piece[64];
+            size_t n;
+            switch (rng() % 3) {
+                case 0:
+                    n = rng() % 40;
+                    rand_str(piece, n, 26);
+                    gl_sb_append(&sb, piece);
+                    break;
+                case 1:
+                    piece[0] = (char)('A' + rng() % 26);
+                    piece[1] = '\0';
+                    n = 1;
+                    gl_sb_appendc(&sb, piece[0]);
+                    break;
+                default:
+                    n = (size_t)snprintf(piece, sizeof(piece), "%d:%x;", (int)rng(), (unsigned)rng());
+                    gl_sb_appendf(&sb, "%s", piece);
+                    break;
+            }
+            memcpy(want + len, piece, n);
+            len += n;
+            want[len] = '\0';
+            if (round == 0 && len < 64 && sb.data != sb.inline_buf)
+                CHECK("strbuf", 0, "%zu bytes already on the heap", len);
+        }
+        CHECK("strbuf", sb.len == len && strcmp(sb.data, want) == 0, "round %d: contents differ", round);
+        CHECK("strbuf", sb.cap >= sb.len, "cap %zu below len %zu", sb.cap, sb.len);
+
+        // Round two starts from a reset buffer, which keeps its memory.
+        if (round == 0) gl_sb_reset(&sb);
+    }
+
+    size_t n;
+    char* s = gl_sb_detach(&sb, &n);
+    CHECK("sb_detach", s && n == strlen(s) && sb.len == 0 && sb.data[0] == '\0', "heap string");
+    gl_free(s);
+
+    gl_sb_append(&sb, "short");
+    s = gl_sb_detach(&sb, &n);
+    CHECK("sb_detach", s && n == 5 && strcmp(s, "short") == 0 && s != sb.inline_buf, "inline string");
+    gl_free(s);
+    gl_sb_free(&sb);
+}
+
+// Strings that end at the last byte before a PROT_NONE page: word-at-a-
+// time scanners must not read past the terminator's word.
+static void test_page_edge(void) {
+    long page = sysconf(_SC_PAGESIZE);
+    unsigned char* map = mmap(NULL, 2 * page, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED) return;
+    mprotect(map + page, page, PROT_NONE);
+
+    for (size_t len = 0; len < 64; len++) {
+        char* s = (char*)map + page - len - 1;
+        memset(s, 'x', len);
+        s[len] = '\0';
+        CHECK("page edge", gl_strlen(s) == len, "strlen len %zu", len);
+        CHECK("page edge", gl_strnlen(s, len + 100) == len, "strnlen len %zu", len);
+        CHECK("page edge", gl_strchr(s, 'y') == NULL, "strchr len %zu", len);
+        CHECK("page edge", gl_strcmp(s, s) == 0, "strcmp len %zu", len);
+        CHECK("page edge", gl_memcmp(s, s, len + 1) == 0, "memcmp len %zu", len);
+    }
+    munmap(map, 2 * page);
+}
+
+void test_string(void) {
+    test_mem();
+    test_str();
+    test_strtok();
+    test_strbuf();
+    test_page_edge();
+}
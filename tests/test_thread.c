@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * tests/test_thread.c
+ *
+ * Threads, mutexes, condition variables, once and rwlocks, run on
+ * host threads through the shim.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include "harness.h"
+
+#define NTHREADS    4
+#define ITERS       100000
+
+#define EBUSY   16
+#define EINVAL  22
+
+static gl_mutex_t lock;
+static long counter;
+
+static void* add_locked(void* arg) {
+    for (int i = 0; i < ITERS; i++) {
+        gl_pthread_mutex_lock(&lock);
+        counter++;
+        gl_pthread_mutex_unlock(&lock);
+    }
+    return arg;
+}
+
+static void check_create_mutex(void) {
+    gl_pthread_t t[NTHREADS];
+    counter = 0;
+    for (intptr_t i = 0; i < NTHREADS; i++)
+        CHECK("pthread_create", gl_pthread_create(&t[i], NULL, add_locked, (void*)i) == 0,
+              "thread %d", (int)i);
+    for (intptr_t i = 0; i < NTHREADS; i++) {
+        void* r = NULL;
+        gl_pthread_join(t[i], &r);
+        CHECK("pthread_join", r == (void*)i, "thread %d returned %p", (int)i, r);
+    }
+    CHECK("mutex", counter == (long)NTHREADS * ITERS, "counter %ld, want %ld",
+          counter, (long)NTHREADS * ITERS);
+}
+
+static void check_trylock(void) {
+    gl_mutex_t m = { 0 };
+    CHECK("trylock", gl_pthread_mutex_trylock(&m) == 0, "free mutex");
+    CHECK("trylock", gl_pthread_mutex_trylock(&m) == EBUSY, "held mutex: want EBUSY");
+    CHECK("mutex_destroy", gl_pthread_mutex_destroy(&m) == EBUSY, "held mutex: want EBUSY");
+    gl_pthread_mutex_unlock(&m);
+    CHECK("mutex_destroy", gl_pthread_mutex_destroy(&m) == 0, "free mutex");
+}
+
+// A one-slot mailbox: producer waits for empty, consumer for full.
+static gl_mutex_t box_lock;
+static gl_cond_t box_cond;
+static int box_full, box_value;
+
+static void* consumer(void* arg) {
+    long sum = 0;
+    (void)arg;
+    for (int i = 0; i < ITERS / 10; i++) {
+        gl_pthread_mutex_lock(&box_lock);
+        while (!box_full)
+            gl_pthread_cond_wait(&box_cond, &box_lock);
+        sum += box_value;
+        box_full = 0;
+        gl_pthread_cond_broadcast(&box_cond);
+        gl_pthread_mutex_unlock(&box_lock);
+    }
+    return (void*)sum;
+}
+
+static void check_cond(void) {
+    gl_pthread_t t;
+    gl_pthread_create(&t, NULL, consumer, NULL);
+    long want = 0;
+    for (int i = 0; i < ITERS / 10; i++) {
+        gl_pthread_mutex_lock(&box_lock);
+        while (box_full)
+            gl_pthread_cond_wait(&box_cond, &box_lock);
+        box_value = i;
+        want += i;
+        box_full = 1;
+        gl_pthread_cond_signal(&box_cond);
+        gl_pthread_mutex_unlock(&box_lock);
+    }
+    void* got;
+    gl_pthread_join(t, &got);
+    CHECK("cond", (long)got == want, "consumer summed %ld, want %ld", (long)got, want);
+}
+
+static gl_once_t once;
+static int once_runs;
+
+static void once_fn(void) {
+    __atomic_fetch_add(&once_runs, 1, __ATOMIC_RELAXED);
+}
+
+static void* call_once(void* arg) {
+    gl_pthread_once(&once, once_fn);
+    return arg;
+}
+
+static void check_once(void) {
+    gl_pthread_t t[NTHREADS];
+    for (int i = 0; i < NTHREADS; i++)
+        gl_pthread_create(&t[i], NULL, call_once, NULL);
+    for (int i = 0; i < NTHREADS; i++)
+        gl_pthread_join(t[i], NULL);
+    CHECK("once", once_runs == 1, "ran %d times", once_runs);
+}
+
+// Writers keep a == b; readers must never see them differ.
+static gl_rwlock_t rw;
+static volatile long rw_a, rw_b;
+
+static void* rw_worker(void* arg) {
+    long torn = 0;
+    for (int i = 0; i < ITERS / 10; i++) {
+        if (((intptr_t)arg + i) % 4 == 0) {
+            gl_pthread_rwlock_wrlock(&rw);
+            rw_a++;
+            rw_b++;
+            gl_pthread_rwlock_unlock(&rw);
+        } else {
+            gl_pthread_rwlock_rdlock(&rw);
+            if (rw_a != rw_b) torn++;
+            gl_pthread_rwlock_unlock(&rw);
+        }
+    }
+    return (void*)torn;
+}
+
+static void check_rwlock(void) {
+    gl_pthread_t t[NTHREADS];
+    for (intptr_t i = 0; i < NTHREADS; i++)
+        gl_pthread_create(&t[i], NULL, rw_worker, (void*)i);
+    long torn = 0;
+    for (int i = 0; i < NTHREADS; i++) {
+        void* r;
+        gl_pthread_join(t[i], &r);
+        torn += (long)r;
+    }
+    CHECK("rwlock", torn == 0, "readers saw %ld torn updates", torn);
+    CHECK("rwlock", rw_a == NTHREADS * (ITERS / 10) / 4, "writes %ld", rw_a);
+    CHECK("rwlock_destroy", gl_pthread_rwlock_destroy(&rw) == 0, "free rwlock");
+}
+
+static void* self_and_key(void* arg) {
+    unsigned int key = (unsigned int)(uintptr_t)arg;
+    gl_pthread_setspecific(key, &key);
+    return gl_pthread_getspecific(key) == &key ? (void*)gl_pthread_self() : NULL;
+}
+
+static void check_self_specific(void) {
+    unsigned int key;
+    CHECK("key_create", gl_pthread_key_create(&key, NULL) == 0, "first key");
+    CHECK("setspecific", gl_pthread_setspecific(1000, NULL) == EINVAL, "bad key: want EINVAL");
+
+    gl_pthread_t t;
+    void* r;
+    gl_pthread_create(&t, NULL, self_and_key, (void*)(uintptr_t)key);
+    gl_pthread_join(t, &r);
+    CHECK("pthread_self", r == (void*)t, "thread saw self %p, created %p", r, (void*)t);
+    CHECK("pthread_self", gl_pthread_self() != t, "main thread sees the child's self");
+}
+
+void test_thread(void) {
+    check_create_mutex();
+    check_trylock();
+    check_cond();
+    check_once();
+    check_rwlock();
+    check_self_specific();
+}
@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * thread/cond.c
+ * 
+ * Condition variables. Waiters sleep on a sequence counter that every
+ * signal bumps, so a wakeup between unlocking the mutex and sleeping
+ * is never lost.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <futex.h>
+#include <pthread.h>
+
+int pthread_cond_init(pthread_cond_t* c, const void* attr) {
+    (void)attr;
+    c->seq = 0;
+    return 0;
+}
+
+int pthread_cond_wait(pthread_cond_t* c, pthread_mutex_t* m) {
+    int seq = __atomic_load_n(&c->seq, __ATOMIC_RELAXED);
+
+    pthread_mutex_unlock(m);
+    futex_wait(&c->seq, seq);
+
+    // Re-acquire in the contended state: other waiters may have been
+    // woken with us and the unlocker must know to wake them in turn.
+    while (__atomic_exchange_n(&m->state, 2, __ATOMIC_ACQUIRE) != 0)
+        futex_wait(&m->state, 2);
+    return 0;
+}
+
+int pthread_cond_signal(pthread_cond_t* c) {
+    __atomic_fetch_add(&c->seq, 1, __ATOMIC_RELEASE);
+    futex_wake(&c->seq, 1);
+    return 0;
+}
+
+int pthread_cond_broadcast(pthread_cond_t* c) {
+    __atomic_fetch_add(&c->seq, 1, __ATOMIC_RELEASE);
+    futex_wake(&c->seq, 0x7fffffff);
+    return 0;
+}
+
+int pthread_cond_destroy(pthread_cond_t* c) {
+    (void)c;
+    return 0;
+}
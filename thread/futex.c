@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * thread/futex.c
+ * 
+ * Futex wait/wake wrappers. Everything that sleeps goes through here.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <syscall.h>
+#include <futex.h>
+#include <sched.h>
+
+int futex_wait(volatile int *addr, int val) {
+    return (int)__syscall2(SYS_FUTEX_WAIT, (long)addr, val);
+}
+
+int futex_wake(volatile int *addr, int count) {
+    return (int)__syscall2(SYS_FUTEX_WAKE, (long)addr, count);
+}
+
+int sched_yield(void) {
+    return (int)__syscall0(SYS_YIELD);
+}
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * thread/lfqueue.c
+ * 
+ * Bounded lock-free MPMC ring queue.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <lockfree.h>
+
+int lf_queue_init(lf_queue* q, size_t capacity) {
+    if (capacity < 2 || (capacity & (capacity - 1)) != 0)
+        return -1;
+
+    q->cells = malloc(capacity * sizeof(struct lf_cell));
+    if (!q->cells) return -1;
+
+    for (size_t i = 0; i < capacity; ++i)
+        atomic_store_explicit(&q->cells[i].seq, i, memory_order_relaxed);
+    q->mask = capacity - 1;
+    atomic_store_explicit(&q->enqueue_pos, 0, memory_order_relaxed);
+    atomic_store_explicit(&q->dequeue_pos, 0, memory_order_relaxed);
+    return 0;
+}
+
+void lf_queue_destroy(lf_queue* q) {
+    free(q->cells);
+    q->cells = NULL;
+}
+
+int lf_queue_push(lf_queue* q, void* data) {
+    struct lf_cell* cell;
+    size_t pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+
+    for (;;) {
+        cell = &q->cells[pos & q->mask];
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+        if (diff == 0) {
+            // Slot is free for this lap; claim it.
+            if (atomic_compare_exchange_weak_explicit(&q->enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            return -1;  // Full: consumers haven't freed this slot yet
+        } else {
+            pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+        }
+    }
+
+    cell->data = data;
+    atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+    return 0;
+}
+
+int lf_queue_pop(lf_queue* q, void** data) {
+    struct lf_cell* cell;
+    size_t pos = atomic_load_explicit(&q->dequeue_pos, memory_order_relaxed);
+
+    for (;;) {
+        cell = &q->cells[pos & q->mask];
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&q->dequeue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            return -1;  // Empty
+        } else {
+            pos = atomic_load_explicit(&q->dequeue_pos, memory_order_relaxed);
+        }
+    }
+
+    *data = cell->data;
+    // Hand the slot back to producers for the next lap.
+    atomic_store_explicit(&cell->seq, pos + q->mask + 1, memory_order_release);
+    return 0;
+}
@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * thread/lfstack.c
+ * 
+ * Lock-free Treiber stack with tagged head.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <lockfree.h>
+
+// Pointer in the low bits, tag in the rest. On 64-bit only the low 48
+// bits of an address are significant, which leaves 16 bits of tag.
+#if UINTPTR_MAX == 0xffffffffu
+#define PTR_BITS 32
+#else
+#define PTR_BITS 48
+#endif
+#define PTR_MASK ((((uint64_t)1) << PTR_BITS) - 1)
+
+static inline struct lf_node* head_ptr(uint64_t h) {
+    return (struct lf_node*)(uintptr_t)(h & PTR_MASK);
+}
+
+static inline uint64_t head_make(struct lf_node* n, uint64_t old) {
+    uint64_t tag = (old >> PTR_BITS) + 1;
+    return (tag << PTR_BITS) | ((uint64_t)(uintptr_t)n & PTR_MASK);
+}
+
+void lf_stack_push(lf_stack* s, struct lf_node* node) {
+    uint64_t old = atomic_load_u64(&s->head);
+    do {
+        node->next = head_ptr(old);
+    } while (!atomic_cas_u64(&s->head, &old, head_make(node, old)));
+}
+
+struct lf_node* lf_stack_pop(lf_stack* s) {
+    uint64_t old = atomic_load_u64(&s->head);
+    struct lf_node* n;
+    do {
+        n = head_ptr(old);
+        if (!n) return NULL;
+        // n may already be popped by someone else; reading n->next is
+        // still safe as long as nodes aren't unmapped, and the tag makes
+        // the CAS fail if that happened.
+    } while (!atomic_cas_u64(&s->head, &old, head_make(n->next, old)));
+    return n;
+}
+
+// The tag survives pops, so an empty stack's head isn't zero.
+int lf_stack_empty(lf_stack* s) {
+    return head_ptr(atomic_load_u64(&s->head)) == NULL;
+}
+
+struct lf_node* lf_stack_pop_all(lf_stack* s) {
+    uint64_t old = atomic_load_u64(&s->head);
+    while (head_ptr(old) && !atomic_cas_u64(&s->head, &old, head_make(NULL, old)))
+        ;
+    return head_ptr(old);
+}
@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * thread/mutex.c
+ * 
+ * Futex-based mutex. Locking and unlocking an uncontended mutex is a
+ * single atomic instruction; the kernel is only entered when there
+ * are waiters.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <errno.h>
+#include <futex.h>
+#include <pthread.h>
+
+#define SPIN_COUNT 100
+
+int pthread_mutex_init(pthread_mutex_t* m, const void* attr) {
+    (void)attr;
+    m->state = 0;
+    return 0;
+}
+
+int pthread_mutex_trylock(pthread_mutex_t* m) {
+    int c = 0;
+    return __atomic_compare_exchange_n(&m->state, &c, 1, 0,
+                                       __ATOMIC_ACQUIRE, __ATOMIC_RELAXED) ? 0 : EBUSY;
+}
+
+int pthread_mutex_lock(pthread_mutex_t* m) {
+    int c = 0;
+    if (__atomic_compare_exchange_n(&m->state, &c, 1, 0,
+                                    __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        return 0;
+
+    // Short spin: critical sections are usually tiny, and a syscall
+    // round trip costs more than a few hundred pause instructions.
+    for (int i = 0; i < SPIN_COUNT && c == 1; ++i) {
+        __builtin_ia32_pause();
+        c = 0;
+        if (__atomic_compare_exchange_n(&m->state, &c, 1, 0,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+            return 0;
+    }
+
+    // Mark the lock contended so the owner knows to wake us.
+    if (c != 2) c = __atomic_exchange_n(&m->state, 2, __ATOMIC_ACQUIRE);
+    while (c != 0) {
+        futex_wait(&m->state, 2);
+        c = __atomic_exchange_n(&m->state, 2, __ATOMIC_ACQUIRE);
+    }
+    return 0;
+}
+
+int pthread_mutex_unlock(pthread_mutex_t* m) {
+    if (__atomic_exchange_n(&m->state, 0, __ATOMIC_RELEASE) == 2)
+        futex_wake(&m->state, 1);
+    return 0;
+}
+
+int pthread_mutex_destroy(pthread_mutex_t* m) {
+    return m->state == 0 ? 0 : EBUSY;
+}
@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * thread/once.c
+ * 
+ * One-time initialization.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <futex.h>
+#include <pthread.h>
+
+#define ONCE_INIT     0
+#define ONCE_RUNNING  1
+#define ONCE_WAITING  2
+#define ONCE_DONE     3
+
+int pthread_once(pthread_once_t* once, void (*fn)(void)) {
+    // Fast path once initialized: one acquire load, no atomics.
+    if (__atomic_load_n(once, __ATOMIC_ACQUIRE) == ONCE_DONE)
+        return 0;
+
+    int s = ONCE_INIT;
+    if (__atomic_compare_exchange_n(once, &s, ONCE_RUNNING, 0,
+                                    __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+        fn();
+        if (__atomic_exchange_n(once, ONCE_DONE, __ATOMIC_RELEASE) == ONCE_WAITING)
+            futex_wake(once, 0x7fffffff);
+        return 0;
+    }
+
+    // Someone else is running fn; wait for them to finish.
+    while (s != ONCE_DONE) {
+        if (s == ONCE_RUNNING)
+            __atomic_compare_exchange_n(once, &s, ONCE_WAITING, 0,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE);
+        if (s != ONCE_DONE) {
+            futex_wait(once, ONCE_WAITING);
+            s = __atomic_load_n(once, __ATOMIC_ACQUIRE);
+        }
+    }
+    return 0;
+}
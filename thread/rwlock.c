@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * thread/rwlock.c
+ * 
+ * Reader-writer lock. Writers get preference: once one is queued, new
+ * readers wait so a steady stream of readers can't starve it.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <errno.h>
+#include <futex.h>
+#include <pthread.h>
+
+int pthread_rwlock_init(pthread_rwlock_t* rw, const void* attr) {
+    (void)attr;
+    rw->state = 0;
+    rw->waiters = 0;
+    rw->writers_waiting = 0;
+    return 0;
+}
+
+int pthread_rwlock_rdlock(pthread_rwlock_t* rw) {
+    for (;;) {
+        int s = __atomic_load_n(&rw->state, __ATOMIC_RELAXED);
+        if (s >= 0 && __atomic_load_n(&rw->writers_waiting, __ATOMIC_RELAXED) == 0) {
+            if (__atomic_compare_exchange_n(&rw->state, &s, s + 1, 0,
+                                            __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+                return 0;
+            continue;
+        }
+        __atomic_fetch_add(&rw->waiters, 1, __ATOMIC_RELAXED);
+        futex_wait(&rw->state, s);
+        __atomic_fetch_sub(&rw->waiters, 1, __ATOMIC_RELAXED);
+    }
+}
+
+int pthread_rwlock_wrlock(pthread_rwlock_t* rw) {
+    int s = 0;
+    if (__atomic_compare_exchange_n(&rw->state, &s, -1, 0,
+                                    __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        return 0;
+
+    __atomic_fetch_add(&rw->writers_waiting, 1, __ATOMIC_RELAXED);
+    for (;;) {
+        s = 0;
+        if (__atomic_compare_exchange_n(&rw->state, &s, -1, 0,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+            break;
+        __atomic_fetch_add(&rw->waiters, 1, __ATOMIC_RELAXED);
+        futex_wait(&rw->state, s);
+        __atomic_fetch_sub(&rw->waiters, 1, __ATOMIC_RELAXED);
+    }
+    __atomic_fetch_sub(&rw->writers_waiting, 1, __ATOMIC_RELAXED);
+    return 0;
+}
+
+int pthread_rwlock_unlock(pthread_rwlock_t* rw) {
+    int s = __atomic_load_n(&rw->state, __ATOMIC_RELAXED);
+    int now;
+
+    if (s == -1) {
+        __atomic_store_n(&rw->state, 0, __ATOMIC_RELEASE);
+        now = 0;
+    } else {
+        now = __atomic_sub_fetch(&rw->state, 1, __ATOMIC_RELEASE);
+    }
+
+    if (now == 0 && __atomic_load_n(&rw->waiters, __ATOMIC_SEQ_CST) > 0)
+        futex_wake(&rw->state, 0x7fffffff);
+    return 0;
+}
+
+int pthread_rwlock_destroy(pthread_rwlock_t* rw) {
+    return rw->state == 0 ? 0 : EBUSY;
+}
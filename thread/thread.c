@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * thread/thread.c
+ * 
+ * Thread creation, joining and thread-specific data.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <syscall.h>
+#include <futex.h>
+#include <pthread.h>
+
+// Thread control block. The segment register (%gs on i386, %fs on
+// x86-64) points here, so the first word must stay the self pointer:
+// pthread_self() is a single segment-relative load.
+struct pthread {
+    struct pthread* self;
+    void* (*start)(void*);
+    void* arg;
+    void* result;
+    void* block;                // malloc'd stack + TCB, freed by join
+    volatile int alive;         // cleared by the kernel once the thread is gone
+    void* specific[PTHREAD_KEYS_MAX];
+};
+
+static struct pthread main_thread = { .self = &main_thread };
+static int threads_active = 0;
+
+#if defined(GOLDLIBC_HOSTED)
+// The host libc owns the segment register in hosted builds (tests/), so
+// the TCB pointer lives in an ordinary TLS variable instead.
+static __thread struct pthread* hosted_self;
+#endif
+
+static volatile int key_count = 0;
+static void (*key_destructors[PTHREAD_KEYS_MAX])(void*);
+
+void __thread_main(struct pthread* t);
+
+// The kernel starts new threads here with the stack pointer at the TCB
+// pointer. On x86-64 the argument goes in a register instead.
+#if defined(__x86_64__)
+__asm__ (
+    ".text\n"
+    "__thread_entry:\n\t"
+    "xorl %ebp, %ebp\n\t"
+    "movq (%rsp), %rdi\n\t"
+    "call __thread_main\n\t"
+    "hlt\n"
+);
+#else
+__asm__ (
+    ".text\n"
+    "__thread_entry:\n\t"
+    "xorl %ebp, %ebp\n\t"
+    "call __thread_main\n\t"
+    "hlt\n"
+);
+#endif
+extern char __thread_entry[];
+
+pthread_t pthread_self(void) {
+    struct pthread* self;
+    if (!threads_active) return &main_thread;
+#if defined(GOLDLIBC_HOSTED)
+    self = hosted_self ? hosted_self : &main_thread;
+#elif defined(__x86_64__)
+    __asm__ ("movq %%fs:0, %0" : "=r"(self));
+#else
+    __asm__ ("movl %%gs:0, %0" : "=r"(self));
+#endif
+    return self;
+}
+
+static void run_destructors(struct pthread* t) {
+    int n = key_count;
+    for (int i = 0; i < n; ++i) {
+        void* v = t->specific[i];
+        if (v && key_destructors[i]) {
+            t->specific[i] = NULL;
+            key_destructors[i](v);
+        }
+    }
+}
+
+void pthread_exit(void* result) {
+    struct pthread* t = pthread_self();
+    t->result = result;
+    run_destructors(t);
+    for (;;) __syscall1(SYS_THREAD_EXIT, (long)&t->alive);
+}
+
+void __thread_main(struct pthread* t) {
+#if defined(GOLDLIBC_HOSTED)
+    hosted_self = t;
+#endif
+    pthread_exit(t->start(t->arg));
+}
+
+int pthread_create(pthread_t* thread, const pthread_attr_t* attr,
+                   void* (*start)(void*), void* arg) {
+    size_t stack_size = attr && attr->stack_size ? attr->stack_size : PTHREAD_STACK_DEFAULT;
+    stack_size = (stack_size + 15) & ~(size_t)15;
+
+    // One allocation: the stack grows down towards the block start, the
+    // TCB sits above it.
+    uint8_t* block = malloc(stack_size + sizeof(struct pthread) + 16);
+    if (!block) return EAGAIN;
+
+    struct pthread* t = (struct pthread*)(((uintptr_t)block + stack_size + 15) & ~(uintptr_t)15);
+    memset(t, 0, sizeof(*t));
+    t->self = t;
+    t->start = start;
+    t->arg = arg;
+    t->block = block;
+    t->alive = 1;
+
+    // The first thread we start also needs the main thread's segment set
+    // up, otherwise pthread_self() on it would read garbage.
+    if (!threads_active) {
+        __syscall1(SYS_SET_TLS, (long)&main_thread);
+        __atomic_store_n(&threads_active, 1, __ATOMIC_RELEASE);
+    }
+
+    uintptr_t* sp = (uintptr_t*)((uintptr_t)t - 16);
+    *sp = (uintptr_t)t;
+
+    long tid = __syscall3(SYS_THREAD_CREATE, (long)__thread_entry, (long)sp, (long)t);
+    if (tid < 0) {
+        free(block);
+        return EAGAIN;
+    }
+
+    *thread = t;
+    return 0;
+}
+
+int pthread_join(pthread_t t, void** result) {
+    int v;
+    while ((v = __atomic_load_n(&t->alive, __ATOMIC_ACQUIRE)) != 0)
+        futex_wait(&t->alive, v);
+
+    if (result) *result = t->result;
+    free(t->block);
+    return 0;
+}
+
+int pthread_key_create(pthread_key_t* key, void (*destructor)(void*)) {
+    int k = __atomic_fetch_add(&key_count, 1, __ATOMIC_RELAXED);
+    if (k >= PTHREAD_KEYS_MAX) {
+        __atomic_fetch_sub(&key_count, 1, __ATOMIC_RELAXED);
+        return EAGAIN;
+    }
+    key_destructors[k] = destructor;
+    *key = k;
+    return 0;
+}
+
+void* pthread_getspecific(pthread_key_t key) {
+    if (key >= PTHREAD_KEYS_MAX) return NULL;
+    return pthread_self()->specific[key];
+}
+
+int pthread_setspecific(pthread_key_t key, const void* value) {
+    if (key >= PTHREAD_KEYS_MAX) return EINVAL;
+    pthread_self()->specific[key] = (void*)value;
+    return 0;
+}
@@ -0,0 +1,238 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * time/clock.c
+ * 
+ * Clocks. Reads are served from the TSC in user space once it has been
+ * calibrated against the kernel clock; until then, and on CPUs without
+ * an invariant TSC, they go through the syscall. Once a second a reader
+ * re-anchors to the kernel clock and re-measures the frequency, so
+ * error from the first, short calibration doesn't accumulate.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <cpuid.h>
+#include <stdatomic.h>
+#include <syscall.h>
+#include <time.h>
+
+#define NSEC_PER_SEC 1000000000ull
+#define CALIBRATION_NS 10000000ull  // measure the TSC over at least 10 ms
+#define RECALIBRATE_NS NSEC_PER_SEC // then re-anchor this often
+
+#define CALIB_NONE    0
+#define CALIB_RUNNING 1
+#define CALIB_DONE    2
+#define CALIB_OFF     3  // no usable TSC, always use the syscall
+
+static atomic_int calib_state = CALIB_OFF;
+static atomic_int recalibrating = 0;
+
+// The conversion below is replaced as a whole by recalibrate(); readers
+// retry if clock_seq moved (or was odd) while they read it.
+static atomic_uint clock_seq;
+static uint64_t anchor_tsc;
+static uint64_t anchor_ns;          // CLOCK_MONOTONIC at anchor_tsc
+static uint64_t realtime_offset;    // CLOCK_REALTIME - CLOCK_MONOTONIC
+static uint32_t tsc_mult;           // ns = cycles * tsc_mult >> tsc_shift
+static uint32_t tsc_shift;
+
+// The first kernel reading. Frequency is measured from here, so each
+// recalibration sees a longer window than the last.
+static uint64_t base_tsc;
+static uint64_t base_ns;
+
+static inline uint64_t ts_to_ns(const struct timespec* ts) {
+    return (uint64_t)ts->tv_sec * NSEC_PER_SEC + ts->tv_nsec;
+}
+
+static inline void ns_to_ts(uint64_t ns, struct timespec* ts) {
+    ts->tv_sec = (time_t)(ns / NSEC_PER_SEC);
+    ts->tv_nsec = (long)(ns % NSEC_PER_SEC);
+}
+
+static inline int sys_clock(clockid_t clk, struct timespec* ts) {
+    return (int)__syscall2(SYS_CLOCK_GETTIME, clk, (long)ts);
+}
+
+// 64x32 multiply and shift without a 128-bit type (shift <= 32).
+static inline uint64_t mul_u64_u32_shr(uint64_t a, uint32_t mul, uint32_t shift) {
+    uint32_t ah = (uint32_t)(a >> 32), al = (uint32_t)a;
+    uint64_t ret = ((uint64_t)al * mul) >> shift;
+    if (ah) ret += ((uint64_t)ah * mul) << (32 - shift);
+    return ret;
+}
+
+// Pick the largest shift that keeps the multiplier in 32 bits.
+static void frequency_to_mult(uint64_t hz, uint32_t* mult, uint32_t* shift) {
+    uint32_t s = 32;
+    while (s > 0 && (NSEC_PER_SEC << s) / hz > 0xffffffffull)
+        s--;
+    *mult = (uint32_t)((NSEC_PER_SEC << s) / hz);
+    *shift = s;
+}
+
+static void set_frequency(uint64_t hz) {
+    frequency_to_mult(hz, &tsc_mult, &tsc_shift);
+}
+
+// Cycles per second over a window of dns nanoseconds. Both sides are
+// scaled down until cycles * 1e9 fits in 64 bits; the window may be
+// long if the clock went unread.
+static uint64_t measure_hz(uint64_t cycles, uint64_t dns) {
+    while (cycles > (1ull << 34)) {
+        cycles >>= 1;
+        dns >>= 1;
+    }
+    return dns ? cycles * NSEC_PER_SEC / dns : 0;
+}
+
+// Read the kernel's two clocks and the TSC as close together as the
+// syscalls allow.
+static int kernel_reading(uint64_t* mono_ns, uint64_t* tsc, uint64_t* real_ns) {
+    struct timespec mono, real;
+    if (sys_clock(CLOCK_MONOTONIC, &mono) < 0) return -1;
+    *tsc = __builtin_ia32_rdtsc();
+    if (sys_clock(CLOCK_REALTIME, &real) < 0) return -1;
+    *mono_ns = ts_to_ns(&mono);
+    *real_ns = ts_to_ns(&real);
+    return 0;
+}
+
+static int take_anchor(void) {
+    uint64_t real_ns;
+    if (kernel_reading(&anchor_ns, &anchor_tsc, &real_ns) != 0) return -1;
+    realtime_offset = real_ns - anchor_ns;
+    base_tsc = anchor_tsc;
+    base_ns = anchor_ns;
+    return 0;
+}
+
+// Called from crt0 before main.
+void __clock_init(void) {
+    unsigned int eax, ebx, ecx, edx;
+
+    // Only an invariant TSC ticks at a constant rate across P-states.
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) || !(edx & (1u << 8)))
+        return;
+    if (take_anchor() != 0)
+        return;
+
+    // Leaf 0x15 gives the exact frequency on newer CPUs; otherwise it is
+    // measured against the kernel clock once 10 ms have passed.
+    if (__get_cpuid(0, &eax, &ebx, &ecx, &edx) && eax >= 0x15 &&
+        __get_cpuid(0x15, &eax, &ebx, &ecx, &edx) && eax && ebx && ecx) {
+        set_frequency((uint64_t)ecx * ebx / eax);
+        atomic_store_explicit(&calib_state, CALIB_DONE, memory_order_release);
+        return;
+    }
+    atomic_store_explicit(&calib_state, CALIB_NONE, memory_order_release);
+}
+
+static void try_calibrate(uint64_t now_ns, uint64_t now_tsc) {
+    uint64_t dns = now_ns - anchor_ns;
+    if (dns < CALIBRATION_NS) return;
+
+    int expected = CALIB_NONE;
+    if (!atomic_compare_exchange_strong(&calib_state, &expected, CALIB_RUNNING))
+        return;
+
+    uint64_t hz = measure_hz(now_tsc - anchor_tsc, dns);
+    if (hz == 0) {
+        atomic_store_explicit(&calib_state, CALIB_OFF, memory_order_release);
+        return;
+    }
+    set_frequency(hz);
+    atomic_store_explicit(&calib_state, CALIB_DONE, memory_order_release);
+}
+
+/*
+ * Move the anchor to a fresh kernel reading and re-measure the
+ * frequency from base. The TSC estimate may have run ahead of the
+ * kernel clock, and CLOCK_MONOTONIC must not step back; in that case
+ * the anchor stays on the estimate and the rate is slowed so the gap
+ * closes by the next recalibration. Falling behind is corrected with a
+ * step forward. One reader does this at a time; the rest carry on with
+ * the old conversion.
+ */
+static void recalibrate(void) {
+    int expected = 0;
+    if (!atomic_compare_exchange_strong(&recalibrating, &expected, 1))
+        return;
+
+    uint64_t mono_ns, tsc, real_ns;
+    uint64_t hz = 0;
+    if (kernel_reading(&mono_ns, &tsc, &real_ns) == 0)
+        hz = measure_hz(tsc - base_tsc, mono_ns - base_ns);
+    if (hz == 0) {
+        atomic_store_explicit(&recalibrating, 0, memory_order_release);
+        return;
+    }
+
+    // Only this thread writes the conversion, so it can read it freely.
+    uint64_t old_ns = anchor_ns + mul_u64_u32_shr(tsc - anchor_tsc, tsc_mult, tsc_shift);
+    if (old_ns > mono_ns) {
+        uint64_t ahead = old_ns - mono_ns;
+        if (ahead > RECALIBRATE_NS / 2) ahead = RECALIBRATE_NS / 2;
+        hz = hz * (RECALIBRATE_NS / 1000) / ((RECALIBRATE_NS - ahead) / 1000);
+    }
+    uint32_t mult, shift;
+    frequency_to_mult(hz, &mult, &shift);
+
+    // Anchor at the switch itself, so a reader still on the old
+    // conversion can't have returned a later time than the new one gives.
+    uint64_t now = __builtin_ia32_rdtsc();
+    uint64_t ns = mono_ns + mul_u64_u32_shr(now - tsc, mult, shift);
+    old_ns = anchor_ns + mul_u64_u32_shr(now - anchor_tsc, tsc_mult, tsc_shift);
+    if (ns < old_ns) ns = old_ns;
+
+    unsigned int seq = atomic_load_explicit(&clock_seq, memory_order_relaxed);
+    atomic_store_explicit(&clock_seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    anchor_tsc = now;
+    anchor_ns = ns;
+    realtime_offset = real_ns - mono_ns;
+    tsc_mult = mult;
+    tsc_shift = shift;
+    atomic_store_explicit(&clock_seq, seq + 2, memory_order_release);
+
+    atomic_store_explicit(&recalibrating, 0, memory_order_release);
+}
+
+int clock_gettime(clockid_t clk, struct timespec* ts) {
+    if (clk != CLOCK_MONOTONIC && clk != CLOCK_REALTIME)
+        return sys_clock(clk, ts);
+
+    int state = atomic_load_explicit(&calib_state, memory_order_acquire);
+    if (state == CALIB_DONE) {
+        uint64_t ns, since, offset;
+        unsigned int seq;
+        do {
+            seq = atomic_load_explicit(&clock_seq, memory_order_acquire);
+            since = mul_u64_u32_shr(__builtin_ia32_rdtsc() - anchor_tsc, tsc_mult, tsc_shift);
+            ns = anchor_ns + since;
+            offset = realtime_offset;
+            atomic_thread_fence(memory_order_acquire);
+        } while ((seq & 1) || atomic_load_explicit(&clock_seq, memory_order_relaxed) != seq);
+
+        if (since >= RECALIBRATE_NS) recalibrate();
+        if (clk == CLOCK_REALTIME) ns += offset;
+        ns_to_ts(ns, ts);
+        return 0;
+    }
+
+    int ret = sys_clock(clk, ts);
+    if (ret == 0 && state == CALIB_NONE && clk == CLOCK_MONOTONIC)
+        try_calibrate(ts_to_ns(ts), __builtin_ia32_rdtsc());
+    return ret;
+}
+
+time_t time(time_t* t) {
+    struct timespec ts;
+    time_t now = clock_gettime(CLOCK_REALTIME, &ts) == 0 ? ts.tv_sec : (time_t)-1;
+    if (t) *t = now;
+    return now;
+}
@@ -8,24 +8,23 @@
  *
  */
 
-void _exit() {
-    asm volatile (
-            "movl $6, %%eax\n\t"
-            "int $0x80\n\t"
-            :
-            :
-            : "eax"
-        );
+#include <stddef.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <syscall.h>
+
+void _exit(int status) {
+    __syscall1(SYS_EXIT, status);
+}
+
+pid_t spawn(const char *path, char *const argv[]) {
+    return (pid_t)__syscall2(SYS_SPAWN, (long)path, (long)argv);
+}
+
+pid_t waitpid(pid_t pid, int *status, int options) {
+    return (pid_t)__syscall3(SYS_WAITPID, pid, (long)status, options);
 }
 
-void spawn(void *path, void *argv) {
-    asm volatile (
-        "movl %0, %%ebx\n\t"
-        "movl %1, %%ecx\n\t"
-        "movl $4, %%eax\n\t"
-        "int $0x80\n\t"
-        :
-        : "r"(path), "r"(argv)
-        : "%eax", "%ebx", "%ecx"
-    );
+pid_t wait(int *status) {
+    return waitpid(-1, status, 0);
 }
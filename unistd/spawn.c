@@ -0,0 +1,220 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * unistd/spawn.c
+ * 
+ * posix_spawn. The kernel's spawn starts the child with a copy of the
+ * caller's descriptor table, so file actions are applied to our own
+ * table around the spawn call and undone afterwards. Saved descriptors
+ * are close-on-exec and numbered above every target, so the child
+ * never sees them and no action can land on one.
+ *
+ * The kernel reports failure as a bare -1, so each error number below
+ * is the likely cause at the step that failed.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <spawn.h>
+#include <pthread.h>
+#include <syscall.h>
+#include <errno.h>
+
+enum { ACT_CLOSE, ACT_DUP2, ACT_OPEN };
+
+struct spawn_action {
+    int type;
+    int fd;         // descriptor the action leaves in place (or closes)
+    int src;        // ACT_DUP2: source descriptor
+    int oflag;      // ACT_OPEN
+    mode_t mode;    // ACT_OPEN
+    char* path;     // ACT_OPEN, owned
+};
+
+struct saved_fd {
+    int fd;
+    int copy;       // -1 if fd was not open: restoring closes it
+    int flags;      // fd's F_GETFD flags, which dup2 doesn't carry over
+};
+
+// Serializes the window in which our descriptor table is rearranged.
+static pthread_mutex_t spawn_lock = PTHREAD_MUTEX_INITIALIZER;
+
+int posix_spawn_file_actions_init(posix_spawn_file_actions_t* fa) {
+    fa->count = 0;
+    fa->cap = 0;
+    fa->actions = NULL;
+    return 0;
+}
+
+int posix_spawn_file_actions_destroy(posix_spawn_file_actions_t* fa) {
+    for (int i = 0; i < fa->count; i++)
+        free(fa->actions[i].path);
+    free(fa->actions);
+    fa->count = fa->cap = 0;
+    fa->actions = NULL;
+    return 0;
+}
+
+static struct spawn_action* add_action(posix_spawn_file_actions_t* fa, int type, int fd) {
+    if (fa->count == fa->cap) {
+        int cap = fa->cap ? fa->cap * 2 : 4;
+        struct spawn_action* a = realloc(fa->actions, cap * sizeof(*a));
+        if (!a) return NULL;
+        fa->actions = a;
+        fa->cap = cap;
+    }
+    struct spawn_action* a = &fa->actions[fa->count++];
+    memset(a, 0, sizeof(*a));
+    a->type = type;
+    a->fd = fd;
+    return a;
+}
+
+int posix_spawn_file_actions_adddup2(posix_spawn_file_actions_t* fa, int fd, int newfd) {
+    if (fd < 0 || newfd < 0) return EBADF;
+    struct spawn_action* a = add_action(fa, ACT_DUP2, newfd);
+    if (!a) return ENOMEM;
+    a->src = fd;
+    return 0;
+}
+
+int posix_spawn_file_actions_addclose(posix_spawn_file_actions_t* fa, int fd) {
+    if (fd < 0) return EBADF;
+    return add_action(fa, ACT_CLOSE, fd) ? 0 : ENOMEM;
+}
+
+int posix_spawn_file_actions_addopen(posix_spawn_file_actions_t* fa, int fd,
+                                     const char* path, int oflag, mode_t mode) {
+    if (fd < 0) return EBADF;
+    char* copy = strdup(path);
+    if (!copy) return ENOMEM;
+    struct spawn_action* a = add_action(fa, ACT_OPEN, fd);
+    if (!a) {
+        free(copy);
+        return ENOMEM;
+    }
+    a->path = copy;
+    a->oflag = oflag;
+    a->mode = mode;
+    return 0;
+}
+
+int posix_spawnattr_init(posix_spawnattr_t* attr) {
+    attr->flags = 0;
+    return 0;
+}
+
+int posix_spawnattr_destroy(posix_spawnattr_t* attr) {
+    (void)attr;
+    return 0;
+}
+
+// Returns 0 or an error number.
+static int apply_action(const struct spawn_action* a) {
+    switch (a->type) {
+        case ACT_CLOSE:
+            close(a->fd);
+            return 0;
+        case ACT_DUP2:
+            return dup2(a->src, a->fd) < 0 ? EBADF : 0;
+        case ACT_OPEN: {
+            int fd = (int)__syscall3(SYS_OPEN, (long)a->path, a->oflag, a->mode);
+            if (fd < 0) return ENOENT;
+            if (fd != a->fd) {
+                int r = dup2(fd, a->fd);
+                close(fd);
+                if (r < 0) return EMFILE;
+            }
+            return 0;
+        }
+    }
+    return EINVAL;
+}
+
+// An open target gets a copy to restore from; if the copy can't be made
+// the spawn must not go ahead, since restoring would then lose the
+// descriptor. Only a target that was closed to begin with (F_GETFD
+// fails) is closed again on restore. The copy itself is close-on-exec,
+// so the child never inherits it.
+static int save_fd(struct saved_fd* s, int fd, int floor) {
+    s->fd = fd;
+    s->copy = -1;
+    s->flags = fcntl(fd, F_GETFD, 0);
+    if (s->flags < 0) return 0;
+    s->copy = fcntl(fd, F_DUPFD_CLOEXEC, floor);
+    return s->copy < 0 ? EMFILE : 0;
+}
+
+// dup2 leaves the restored descriptor without FD_CLOEXEC, so the saved
+// flags are put back too.
+static void restore_fds(struct saved_fd* saved, int n) {
+    while (n--) {
+        if (saved[n].copy >= 0) {
+            dup2(saved[n].copy, saved[n].fd);
+            fcntl(saved[n].fd, F_SETFD, saved[n].flags);
+            close(saved[n].copy);
+        } else {
+            close(saved[n].fd);
+        }
+    }
+}
+
+int posix_spawn(pid_t* pid, const char* path,
+                const posix_spawn_file_actions_t* fa,
+                const posix_spawnattr_t* attr,
+                char* const argv[], char* const envp[]) {
+    (void)attr;
+    int nact = fa ? fa->count : 0;
+
+    // envp rides in the third argument register; kernels that only take
+    // (path, argv) ignore it.
+    if (nact == 0) {
+        long r = __syscall3(SYS_SPAWN, (long)path, (long)argv, (long)envp);
+        if (r < 0) return ENOENT;
+        if (pid) *pid = (pid_t)r;
+        return 0;
+    }
+
+    struct saved_fd* saved = malloc(nact * sizeof(*saved));
+    if (!saved) return ENOMEM;
+
+    int floor = 0;
+    for (int i = 0; i < nact; i++)
+        if (fa->actions[i].fd >= floor) floor = fa->actions[i].fd + 1;
+
+    pthread_mutex_lock(&spawn_lock);
+
+    // Save each distinct target once, before any action runs.
+    int nsaved = 0, err = 0;
+    for (int i = 0; i < nact && !err; i++) {
+        int fd = fa->actions[i].fd, seen = 0;
+        for (int j = 0; j < nsaved; j++)
+            if (saved[j].fd == fd) seen = 1;
+        if (seen) continue;
+        err = save_fd(&saved[nsaved], fd, floor);
+        if (!err) nsaved++;
+    }
+
+    for (int i = 0; i < nact && !err; i++)
+        err = apply_action(&fa->actions[i]);
+
+    long r = -1;
+    if (!err) {
+        r = __syscall3(SYS_SPAWN, (long)path, (long)argv, (long)envp);
+        if (r < 0) err = ENOENT;
+    }
+
+    restore_fds(saved, nsaved);
+    pthread_mutex_unlock(&spawn_lock);
+    free(saved);
+
+    if (err) return err;
+    if (pid) *pid = (pid_t)r;
+    return 0;
+}
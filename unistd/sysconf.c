@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: LGPL-2.1-only
+/*
+ * unistd/sysconf.c
+ * 
+ * Runtime system limits.
+ *
+ * Copyright (C) 2026 Goldside543
+ *
+ */
+
+#include <syscall.h>
+#include <unistd.h>
+
+long sysconf(int name) {
+    switch (name) {
+        case _SC_NPROCESSORS_ONLN: {
+            long n = __syscall0(SYS_NPROCS);
+            return n > 0 ? n : -1;
+        }
+        default:
+            return -1;
+    }
+}